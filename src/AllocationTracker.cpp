@@ -0,0 +1,181 @@
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+
+    std::atomic<bool> enabled(false);
+    std::atomic<std::size_t> allocations(0);
+    std::atomic<std::size_t> deallocations(0);
+    std::atomic<std::size_t> requestedBytes(0);
+    std::atomic<std::size_t> usableBytes(0);
+    std::atomic<long long> liveBytes(0);
+    std::atomic<long long> peakLiveBytes(0);
+
+    std::size_t usableSize(void *pointer, std::size_t requested)
+    {
+#ifdef __GLIBC__
+        (void)requested;
+        return malloc_usable_size(pointer);
+#else
+        (void)pointer;
+        return requested;
+#endif
+    }
+
+    void recordAllocation(void *pointer, std::size_t size)
+    {
+        const std::size_t usable = usableSize(pointer, size);
+
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        requestedBytes.fetch_add(size, std::memory_order_relaxed);
+        usableBytes.fetch_add(usable, std::memory_order_relaxed);
+
+        long long live = liveBytes.fetch_add(usable, std::memory_order_relaxed) + usable;
+        long long peak = peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {}
+    }
+
+    void recordDeallocation(void *pointer)
+    {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(usableSize(pointer, 0), std::memory_order_relaxed);
+    }
+
+    void *allocate(std::size_t size)
+    {
+        void *pointer = std::malloc(size ? size : 1);
+        if (!pointer)
+            throw std::bad_alloc();
+
+        if (enabled.load(std::memory_order_relaxed))
+            recordAllocation(pointer, size);
+        return pointer;
+    }
+
+    void deallocate(void *pointer)
+    {
+        if (!pointer)
+            return;
+
+        if (enabled.load(std::memory_order_relaxed))
+            recordDeallocation(pointer);
+        std::free(pointer);
+    }
+
+}
+
+namespace aisdi
+{
+
+    constexpr std::size_t AllocationStatistics::MALLOC_HEADER_BYTES;
+
+    void AllocationTracker::enable(bool enable)
+    {
+        enabled.store(enable);
+    }
+
+    bool AllocationTracker::isEnabled()
+    {
+        return enabled.load();
+    }
+
+    void AllocationTracker::reset()
+    {
+        allocations = 0;
+        deallocations = 0;
+        requestedBytes = 0;
+        usableBytes = 0;
+        liveBytes = 0;
+        peakLiveBytes = 0;
+    }
+
+    AllocationStatistics AllocationTracker::snapshot()
+    {
+        AllocationStatistics statistics;
+        statistics.allocations = allocations.load();
+        statistics.deallocations = deallocations.load();
+        statistics.requestedBytes = requestedBytes.load();
+        statistics.usableBytes = usableBytes.load();
+        statistics.liveBytes = liveBytes.load();
+        statistics.peakLiveBytes = peakLiveBytes.load();
+        return statistics;
+    }
+
+    std::size_t AllocationTracker::peakResidentBytes()
+    {
+#ifdef __unix__
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+            return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // kilobytes on Linux
+#endif
+        return 0;
+    }
+
+}
+
+void *operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
@@ -0,0 +1,89 @@
+#ifndef AISDI_LINEAR_ALLOCATIONTRACKER_H
+#define AISDI_LINEAR_ALLOCATIONTRACKER_H
+
+#include <cstddef>
+
+namespace aisdi
+{
+
+    // Heap activity between AllocationTracker::reset() and snapshot().
+    // Byte counts are net: blocks freed in the window count negatively even
+    // if they were allocated before it.
+    struct AllocationStatistics
+    {
+        // Bookkeeping malloc keeps next to each block, on 64-bit glibc.
+        static constexpr std::size_t MALLOC_HEADER_BYTES = sizeof(std::size_t);
+
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        // Sum of the sizes passed to operator new.
+        std::size_t requestedBytes = 0;
+        // Usable sizes (malloc_usable_size) allocated minus freed.
+        long long liveBytes = 0;
+        long long peakLiveBytes = 0;
+        // Usable sizes of the allocated blocks; exceeds requestedBytes by
+        // malloc's rounding.
+        std::size_t usableBytes = 0;
+
+        long long liveBlocks() const
+        {
+            return static_cast<long long>(allocations) - static_cast<long long>(deallocations);
+        }
+
+        // Live bytes including an estimate of malloc's per-block headers.
+        long long liveHeapBytes() const
+        {
+            return liveBytes + liveBlocks() * static_cast<long long>(MALLOC_HEADER_BYTES);
+        }
+    };
+
+    // Counts what the replacement global operator new and delete (in
+    // AllocationTracker.cpp, linked into the benchmark binary only) do
+    // while tracking is enabled. Disabled, the replacements only pay for
+    // checking a flag. Counters are atomic, so concurrent benchmarks are
+    // counted too.
+    class AllocationTracker
+    {
+    public:
+        static void enable(bool enabled);
+        static bool isEnabled();
+
+        // Starts a new window of counting.
+        static void reset();
+        static AllocationStatistics snapshot();
+
+        // Peak resident set size of the process so far, from getrusage.
+        static std::size_t peakResidentBytes();
+    };
+
+    // Tracks allocations for the lifetime of the object, restoring the
+    // previous state afterwards.
+    class AllocationScope
+    {
+        bool wasEnabled;
+
+    public:
+        AllocationScope()
+            : wasEnabled(AllocationTracker::isEnabled())
+        {
+            AllocationTracker::reset();
+            AllocationTracker::enable(true);
+        }
+
+        ~AllocationScope()
+        {
+            AllocationTracker::enable(wasEnabled);
+        }
+
+        AllocationScope(const AllocationScope &) = delete;
+        AllocationScope &operator=(const AllocationScope &) = delete;
+
+        AllocationStatistics snapshot() const
+        {
+            return AllocationTracker::snapshot();
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_ALLOCATIONTRACKER_H
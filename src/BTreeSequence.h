@@ -0,0 +1,902 @@
+#ifndef AISDI_LINEAR_BTREESEQUENCE_H
+#define AISDI_LINEAR_BTREESEQUENCE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+    namespace detail
+    {
+        // Elements per leaf: four cache lines worth, but never fewer than 8.
+        constexpr std::size_t btreeLeafCapacity(std::size_t elementSize)
+        {
+            return elementSize * 8 > 256 ? 8 : 256 / elementSize;
+        }
+    }
+
+    // Counted B+-tree used as a sequence: position, not key, selects where an
+    // element goes. Inner nodes store the size of every child subtree, so
+    // locating index i is a descent that subtracts counts, and indexing,
+    // insert and erase all cost O(log n). Elements live only in leaves,
+    // which are doubly linked for sequential iteration.
+    //
+    // Iterators remember their leaf and offset for cheap scans; any insert
+    // or erase invalidates them.
+    template<typename Type>
+    class BTreeSequence
+    {
+    public:
+        class ConstIterator;
+        class Iterator;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type *;
+        using reference = Type &;
+        using const_pointer = const Type *;
+        using const_reference = const Type &;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        static constexpr size_type LEAF_CAPACITY = detail::btreeLeafCapacity(sizeof(Type));
+        static constexpr size_type INNER_CAPACITY = 16;
+
+    private:
+        struct Node
+        {
+            bool isLeaf;
+            size_type count;
+
+            explicit Node(bool isLeaf)
+                : isLeaf(isLeaf),
+                  count(0)
+            {}
+        };
+
+        struct Leaf : public Node
+        {
+            Leaf *prev;
+            Leaf *next;
+            typename std::aligned_storage<sizeof(Type), alignof(Type)>::type slots[LEAF_CAPACITY];
+
+            Leaf()
+                : Node(true),
+                  prev(nullptr),
+                  next(nullptr)
+            {}
+
+            pointer slot(size_type position)
+            {
+                return reinterpret_cast<pointer>(&slots[position]);
+            }
+        };
+
+        struct Inner : public Node
+        {
+            size_type counts[INNER_CAPACITY];
+            Node *children[INNER_CAPACITY];
+
+            Inner()
+                : Node(false)
+            {}
+        };
+
+        Node *root;
+        Leaf *firstLeaf;
+        Leaf *lastLeaf;
+        size_type size;
+
+    public:
+        explicit BTreeSequence()
+            : root(nullptr),
+              firstLeaf(nullptr),
+              lastLeaf(nullptr),
+              size(0)
+        {}
+
+        BTreeSequence(std::initializer_list<Type> l)
+            : BTreeSequence()
+        {
+            copyFrom(l);
+        }
+
+        BTreeSequence(const BTreeSequence &other)
+            : BTreeSequence()
+        {
+            copyFrom(other);
+        }
+
+        BTreeSequence(BTreeSequence &&other) noexcept
+            : BTreeSequence()
+        {
+            moveFrom(other);
+        }
+
+        ~BTreeSequence()
+        {
+            deleteTree();
+        }
+
+        BTreeSequence &operator=(const BTreeSequence &other)
+        {
+            if (this == &other)
+                return *this;
+
+            deleteTree();
+            copyFrom(other);
+
+            return *this;
+        }
+
+        BTreeSequence &operator=(BTreeSequence &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            deleteTree();
+            moveFrom(other);
+
+            return *this;
+        }
+
+        bool isEmpty() const
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const
+        {
+            return size;
+        }
+
+        reference operator[](size_type index)
+        {
+            size_type offset;
+            Leaf *leaf = locate(index, offset);
+            return *leaf->slot(offset);
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            size_type offset;
+            Leaf *leaf = locate(index, offset);
+            return *leaf->slot(offset);
+        }
+
+        void append(const Type &item)
+        {
+            insertAt(size, item);
+        }
+
+        void prepend(const Type &item)
+        {
+            insertAt(0, item);
+        }
+
+        void insert(const const_iterator &insertPosition, const Type &item)
+        {
+            insertAt(insertPosition.getIndex(), item);
+        }
+
+        void insertAt(size_type index, const Type &item)
+        {
+            if (root == nullptr)
+            {
+                Leaf *leaf = new Leaf();
+                root = firstLeaf = lastLeaf = leaf;
+            }
+
+            Node *split = insertInto(root, index, item);
+            if (split != nullptr)
+                growRoot(split);
+
+            size++;
+        }
+
+        Type popFirst()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popFirst when collection is empty");
+
+            Type value = std::move(*firstLeaf->slot(0));
+            eraseAt(0);
+            return value;
+        }
+
+        Type popLast()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popLast when collection is empty");
+
+            Type value = std::move(*lastLeaf->slot(lastLeaf->count - 1));
+            eraseAt(size - 1);
+            return value;
+        }
+
+        void erase(const const_iterator &position)
+        {
+            throwIfCollectionEmpty<std::out_of_range>(
+                    "cannot erase from empty collection");
+
+            throwIfIteratorEqualsEnd<std::out_of_range>(
+                    position,
+                    "cannot erase end");
+
+            eraseAt(position.getIndex());
+        }
+
+        void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+        {
+            size_type first = firstIncluded.getIndex();
+            size_type count = lastExcluded.getIndex() - first;
+
+            for (size_type i = 0; i < count; i++)
+                eraseAt(first);
+        }
+
+        iterator begin()
+        {
+            return Iterator(this, firstLeaf, 0, 0);
+        }
+
+        iterator end()
+        {
+            return createEnd();
+        }
+
+        const_iterator cbegin() const
+        {
+            return ConstIterator(this, firstLeaf, 0, 0);
+        }
+
+        const_iterator cend() const
+        {
+            return createEnd();
+        }
+
+        const_iterator begin() const
+        {
+            return cbegin();
+        }
+
+        const_iterator end() const
+        {
+            return cend();
+        }
+
+    private:
+        ConstIterator createEnd() const
+        {
+            return ConstIterator(this, lastLeaf, lastLeaf == nullptr ? 0 : lastLeaf->count, size);
+        }
+
+        ConstIterator createIterator(size_type index) const
+        {
+            if (index >= size)
+                return createEnd();
+
+            size_type offset;
+            Leaf *leaf = locate(index, offset);
+            return ConstIterator(this, leaf, offset, index);
+        }
+
+        Leaf *locate(size_type index, size_type &offset) const
+        {
+            Node *node = root;
+
+            while (!node->isLeaf)
+            {
+                Inner *inner = static_cast<Inner*>(node);
+                size_type child = 0;
+
+                while (index >= inner->counts[child])
+                    index -= inner->counts[child++];
+
+                node = inner->children[child];
+            }
+
+            offset = index;
+            return static_cast<Leaf*>(node);
+        }
+
+        static size_type countOf(Node *node)
+        {
+            if (node->isLeaf)
+                return node->count;
+
+            Inner *inner = static_cast<Inner*>(node);
+            size_type total = 0;
+
+            for (size_type i = 0; i < inner->count; i++)
+                total += inner->counts[i];
+
+            return total;
+        }
+
+        // Returns the new right sibling when node had to split.
+        Node *insertInto(Node *node, size_type index, const Type &item)
+        {
+            if (node->isLeaf)
+                return insertIntoLeaf(static_cast<Leaf*>(node), index, item);
+
+            Inner *inner = static_cast<Inner*>(node);
+            size_type child = 0;
+
+            while (child + 1 < inner->count && index > inner->counts[child])
+                index -= inner->counts[child++];
+
+            Node *split = insertInto(inner->children[child], index, item);
+            if (split == nullptr)
+            {
+                inner->counts[child]++;
+                return nullptr;
+            }
+
+            inner->counts[child] = countOf(inner->children[child]);
+            return insertChild(inner, child + 1, split);
+        }
+
+        Leaf *insertIntoLeaf(Leaf *leaf, size_type position, const Type &item)
+        {
+            if (leaf->count < LEAF_CAPACITY)
+            {
+                insertIntoLeafInPlace(leaf, position, item);
+                return nullptr;
+            }
+
+            Leaf *right = new Leaf();
+            linkLeafAfter(leaf, right);
+
+            // Filling leaves completely keeps pure append/prepend streams
+            // dense instead of leaving every leaf half empty.
+            if (position == leaf->count && right == lastLeaf)
+            {
+                insertIntoLeafInPlace(right, 0, item);
+            }
+            else if (position == 0 && leaf == firstLeaf)
+            {
+                relocate(leaf, 0, right, 0, leaf->count);
+                insertIntoLeafInPlace(leaf, 0, item);
+            }
+            else
+            {
+                size_type half = LEAF_CAPACITY / 2;
+                relocate(leaf, half, right, 0, leaf->count - half);
+
+                if (position <= half)
+                    insertIntoLeafInPlace(leaf, position, item);
+                else
+                    insertIntoLeafInPlace(right, position - half, item);
+            }
+
+            return right;
+        }
+
+        void insertIntoLeafInPlace(Leaf *leaf, size_type position, const Type &item)
+        {
+            for (size_type i = leaf->count; i > position; i--)
+                relocate(leaf->slot(i - 1), leaf->slot(i));
+
+            new (leaf->slot(position)) Type(item);
+            leaf->count++;
+        }
+
+        Inner *insertChild(Inner *inner, size_type position, Node *child)
+        {
+            if (inner->count < INNER_CAPACITY)
+            {
+                insertChildInPlace(inner, position, child);
+                return nullptr;
+            }
+
+            Inner *right = new Inner();
+            size_type half = INNER_CAPACITY / 2;
+            moveChildren(inner, half, right, 0, inner->count - half);
+
+            if (position <= half)
+                insertChildInPlace(inner, position, child);
+            else
+                insertChildInPlace(right, position - half, child);
+
+            return right;
+        }
+
+        void insertChildInPlace(Inner *inner, size_type position, Node *child)
+        {
+            for (size_type i = inner->count; i > position; i--)
+            {
+                inner->children[i] = inner->children[i - 1];
+                inner->counts[i] = inner->counts[i - 1];
+            }
+
+            inner->children[position] = child;
+            inner->counts[position] = countOf(child);
+            inner->count++;
+        }
+
+        void growRoot(Node *split)
+        {
+            Inner *newRoot = new Inner();
+
+            newRoot->children[0] = root;
+            newRoot->counts[0] = countOf(root);
+            newRoot->children[1] = split;
+            newRoot->counts[1] = countOf(split);
+            newRoot->count = 2;
+
+            root = newRoot;
+        }
+
+        void eraseAt(size_type index)
+        {
+            eraseFrom(root, index);
+            size--;
+
+            if (!root->isLeaf && root->count == 1)
+            {
+                Inner *oldRoot = static_cast<Inner*>(root);
+                root = oldRoot->children[0];
+                delete oldRoot;
+            }
+            else if (root->isLeaf && root->count == 0)
+            {
+                delete static_cast<Leaf*>(root);
+                root = firstLeaf = lastLeaf = nullptr;
+            }
+        }
+
+        void eraseFrom(Node *node, size_type index)
+        {
+            if (node->isLeaf)
+                return eraseFromLeaf(static_cast<Leaf*>(node), index);
+
+            Inner *inner = static_cast<Inner*>(node);
+            size_type child = 0;
+
+            while (index >= inner->counts[child])
+                index -= inner->counts[child++];
+
+            inner->counts[child]--;
+            eraseFrom(inner->children[child], index);
+
+            if (isUnderfull(inner->children[child]))
+                rebalance(inner, child);
+        }
+
+        void eraseFromLeaf(Leaf *leaf, size_type position)
+        {
+            leaf->slot(position)->~Type();
+
+            for (size_type i = position + 1; i < leaf->count; i++)
+                relocate(leaf->slot(i), leaf->slot(i - 1));
+
+            leaf->count--;
+        }
+
+        static bool isUnderfull(Node *node)
+        {
+            return node->count < (node->isLeaf ? LEAF_CAPACITY : INNER_CAPACITY) / 2;
+        }
+
+        // Merges child with a neighbour, or borrows from it when both do not
+        // fit into a single node.
+        void rebalance(Inner *parent, size_type child)
+        {
+            if (parent->count < 2)
+                return;
+
+            size_type leftIndex = child > 0 ? child - 1 : child;
+            Node *left = parent->children[leftIndex];
+            Node *right = parent->children[leftIndex + 1];
+
+            if (left->isLeaf)
+                rebalanceLeaves(parent, leftIndex, static_cast<Leaf*>(left), static_cast<Leaf*>(right));
+            else
+                rebalanceInners(parent, leftIndex, static_cast<Inner*>(left), static_cast<Inner*>(right));
+        }
+
+        void rebalanceLeaves(Inner *parent, size_type leftIndex, Leaf *left, Leaf *right)
+        {
+            size_type total = left->count + right->count;
+
+            if (total <= LEAF_CAPACITY)
+            {
+                relocate(right, 0, left, left->count, right->count);
+                unlinkLeaf(right);
+                delete right;
+                removeChild(parent, leftIndex + 1);
+                return;
+            }
+
+            if (left->count > total / 2)
+            {
+                size_type moved = left->count - total / 2;
+                for (size_type i = right->count; i > 0; i--)
+                    relocate(right->slot(i - 1), right->slot(i - 1 + moved));
+                right->count += moved;
+                left->count -= moved;
+                for (size_type i = 0; i < moved; i++)
+                    relocate(left->slot(left->count + i), right->slot(i));
+            }
+            else
+            {
+                size_type moved = total / 2 - left->count;
+                relocate(right, 0, left, left->count, moved);
+                for (size_type i = moved; i < right->count + moved; i++)
+                    relocate(right->slot(i), right->slot(i - moved));
+            }
+
+            parent->counts[leftIndex] = left->count;
+            parent->counts[leftIndex + 1] = right->count;
+        }
+
+        void rebalanceInners(Inner *parent, size_type leftIndex, Inner *left, Inner *right)
+        {
+            size_type total = left->count + right->count;
+
+            if (total <= INNER_CAPACITY)
+            {
+                moveChildren(right, 0, left, left->count, right->count);
+                delete right;
+                removeChild(parent, leftIndex + 1);
+                return;
+            }
+
+            if (left->count > total / 2)
+            {
+                size_type moved = left->count - total / 2;
+                for (size_type i = right->count; i > 0; i--)
+                {
+                    right->children[i - 1 + moved] = right->children[i - 1];
+                    right->counts[i - 1 + moved] = right->counts[i - 1];
+                }
+                moveChildren(left, left->count - moved, right, 0, moved);
+            }
+            else
+            {
+                size_type moved = total / 2 - left->count;
+                moveChildren(right, 0, left, left->count, moved);
+                for (size_type i = moved; i < right->count + moved; i++)
+                {
+                    right->children[i - moved] = right->children[i];
+                    right->counts[i - moved] = right->counts[i];
+                }
+            }
+
+            parent->counts[leftIndex] = countOf(left);
+            parent->counts[leftIndex + 1] = countOf(right);
+        }
+
+        // Drops the child at position after it was merged into its left sibling.
+        void removeChild(Inner *inner, size_type position)
+        {
+            inner->counts[position - 1] += inner->counts[position];
+
+            for (size_type i = position + 1; i < inner->count; i++)
+            {
+                inner->children[i - 1] = inner->children[i];
+                inner->counts[i - 1] = inner->counts[i];
+            }
+
+            inner->count--;
+        }
+
+        // Moves count leading elements of from, starting at fromPosition, to
+        // the (free) slots of to starting at toPosition.
+        static void relocate(Leaf *from, size_type fromPosition, Leaf *to, size_type toPosition, size_type count)
+        {
+            for (size_type i = 0; i < count; i++)
+                relocate(from->slot(fromPosition + i), to->slot(toPosition + i));
+
+            from->count -= count;
+            to->count += count;
+        }
+
+        static void relocate(pointer from, pointer to)
+        {
+            new (to) Type(std::move(*from));
+            from->~Type();
+        }
+
+        static void moveChildren(Inner *from, size_type fromPosition, Inner *to, size_type toPosition, size_type count)
+        {
+            for (size_type i = 0; i < count; i++)
+            {
+                to->children[toPosition + i] = from->children[fromPosition + i];
+                to->counts[toPosition + i] = from->counts[fromPosition + i];
+            }
+
+            from->count -= count;
+            to->count += count;
+        }
+
+        void linkLeafAfter(Leaf *left, Leaf *right)
+        {
+            right->prev = left;
+            right->next = left->next;
+
+            if (left->next != nullptr)
+                left->next->prev = right;
+            else
+                lastLeaf = right;
+
+            left->next = right;
+        }
+
+        void unlinkLeaf(Leaf *leaf)
+        {
+            if (leaf->prev != nullptr)
+                leaf->prev->next = leaf->next;
+            else
+                firstLeaf = leaf->next;
+
+            if (leaf->next != nullptr)
+                leaf->next->prev = leaf->prev;
+            else
+                lastLeaf = leaf->prev;
+        }
+
+        void deleteTree()
+        {
+            if (root != nullptr)
+                deleteNode(root);
+
+            root = firstLeaf = lastLeaf = nullptr;
+            size = 0;
+        }
+
+        static void deleteNode(Node *node)
+        {
+            if (node->isLeaf)
+            {
+                Leaf *leaf = static_cast<Leaf*>(node);
+                for (size_type i = 0; i < leaf->count; i++)
+                    leaf->slot(i)->~Type();
+                delete leaf;
+                return;
+            }
+
+            Inner *inner = static_cast<Inner*>(node);
+            for (size_type i = 0; i < inner->count; i++)
+                deleteNode(inner->children[i]);
+            delete inner;
+        }
+
+        template<class Collection>
+        void copyFrom(const Collection &collection)
+        {
+            for (auto& el : collection)
+                append(el);
+        }
+
+        void moveFrom(BTreeSequence &other)
+        {
+            std::swap(root, other.root);
+            std::swap(firstLeaf, other.firstLeaf);
+            std::swap(lastLeaf, other.lastLeaf);
+            std::swap(size, other.size);
+        }
+
+        template <typename Exception>
+        void throwIfCollectionEmpty(const char *message) const
+        {
+            if (isEmpty())
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfIteratorEqualsEnd(const ConstIterator &iterator, const char *message) const
+        {
+            if (iterator.getIndex() >= size)
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    constexpr typename BTreeSequence<Type>::size_type BTreeSequence<Type>::LEAF_CAPACITY;
+
+    template<typename Type>
+    constexpr typename BTreeSequence<Type>::size_type BTreeSequence<Type>::INNER_CAPACITY;
+
+    template<typename Type>
+    class BTreeSequence<Type>::ConstIterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename BTreeSequence::value_type;
+        using difference_type = typename BTreeSequence::difference_type;
+        using pointer = typename BTreeSequence::const_pointer;
+        using reference = typename BTreeSequence::const_reference;
+        using size_type = typename BTreeSequence::size_type;
+
+        friend class BTreeSequence;
+
+    private:
+        const BTreeSequence *collection;
+        Leaf *leaf;
+        size_type offset;
+        size_type index;
+
+    public:
+        explicit ConstIterator(const BTreeSequence *collection, Leaf *leaf, size_type offset, size_type index)
+            : collection(collection),
+              leaf(leaf),
+              offset(offset),
+              index(index)
+        {}
+
+        ConstIterator()
+            : collection(nullptr),
+              leaf(nullptr),
+              offset(0),
+              index(0)
+        {}
+
+        reference operator*() const
+        {
+            throwIfEnd<std::out_of_range>(
+                    "end iterator cannot be dereferenced");
+
+            return *leaf->slot(offset);
+        }
+
+        ConstIterator &operator++()
+        {
+            throwIfEnd<std::out_of_range>(
+                    "cannot increment end iterator");
+
+            index++;
+            offset++;
+
+            if (offset == leaf->count && leaf->next != nullptr)
+            {
+                leaf = leaf->next;
+                offset = 0;
+            }
+
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator old = *this;
+            operator++();
+            return old;
+        }
+
+        ConstIterator &operator--()
+        {
+            throwIfBegin<std::out_of_range>(
+                    "cannot decrement begin iterator");
+
+            index--;
+
+            if (offset == 0)
+            {
+                leaf = leaf->prev;
+                offset = leaf->count;
+            }
+
+            offset--;
+
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator old = *this;
+            operator--();
+            return old;
+        }
+
+        ConstIterator operator+(difference_type d) const
+        {
+            return collection->createIterator(index + d);
+        }
+
+        ConstIterator operator-(difference_type d) const
+        {
+            return collection->createIterator(index - d);
+        }
+
+        bool operator==(const ConstIterator &other) const
+        {
+            return collection == other.collection && index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const
+        {
+            return !operator==(other);
+        }
+
+    protected:
+        size_type getIndex() const
+        {
+            return index;
+        }
+
+        template <typename Exception>
+        void throwIfBegin(const char *message) const
+        {
+            if (index == 0)
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfEnd(const char *message) const
+        {
+            if (index >= collection->getSize())
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    class BTreeSequence<Type>::Iterator : public BTreeSequence<Type>::ConstIterator
+    {
+    public:
+        using pointer = typename BTreeSequence::pointer;
+        using reference = typename BTreeSequence::reference;
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other)
+        {}
+
+        explicit Iterator(BTreeSequence *collection, Leaf *leaf, size_type offset, size_type index)
+            : ConstIterator(collection, leaf, offset, index)
+        {}
+
+        Iterator &operator++()
+        {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--()
+        {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator operator+(difference_type d) const
+        {
+            return ConstIterator::operator+(d);
+        }
+
+        Iterator operator-(difference_type d) const
+        {
+            return ConstIterator::operator-(d);
+        }
+
+        reference operator*() const
+        {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_BTREESEQUENCE_H
@@ -0,0 +1,350 @@
+#ifndef AISDI_LINEAR_BENCHMARK_H
+#define AISDI_LINEAR_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "PerfCounters.h"
+
+namespace aisdi
+{
+
+    // Keeps the compiler from discarding a value whose computation is being
+    // measured.
+    template<typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Forces pending writes to memory to be considered observable.
+    inline void clobberMemory()
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    struct BenchmarkSettings
+    {
+        std::size_t warmupRuns = 1;
+        std::size_t minRuns = 5;
+        std::size_t maxRuns = 50;
+        // Stop once the 95% confidence interval of the mean is within this
+        // fraction of the mean.
+        double targetRelativeError = 0.02;
+        // Stop after this much measuring (setup included), provided minRuns
+        // were made.
+        std::chrono::duration<double> timeBudget = std::chrono::seconds(2);
+        // Also count hardware events around each run, where permitted.
+        bool hardwareCounters = false;
+
+        // For searches and sweeps that take many measurements: fewer runs,
+        // a looser target and a short budget for each.
+        BenchmarkSettings relaxed() const
+        {
+            BenchmarkSettings settings = *this;
+            settings.maxRuns = std::min<std::size_t>(maxRuns, 15);
+            settings.targetRelativeError = std::max(targetRelativeError, 0.05);
+            settings.timeBudget = std::min(timeBudget, std::chrono::duration<double>(0.25));
+            return settings;
+        }
+    };
+
+    struct BenchmarkStatistics
+    {
+        std::size_t runs = 0;
+        std::size_t operationsPerRun = 0;
+        double mean = 0;
+        double median = 0;
+        double p10 = 0;
+        double p90 = 0;
+        double stddev = 0;
+        double relativeError = 0;
+        // Hardware event counts averaged over runs; empty unless requested
+        // and permitted.
+        PerfSample hardware;
+
+        // Times are in seconds per run.
+        double operationsPerSecond() const
+        {
+            return median > 0 ? operationsPerRun / median : 0;
+        }
+
+        double nanosecondsPerOperation() const
+        {
+            return operationsPerRun > 0 ? median * 1e9 / operationsPerRun : 0;
+        }
+
+        double hardwarePerOperation(PerfEvent event) const
+        {
+            return operationsPerRun > 0 ? hardware.values[event] / operationsPerRun : 0;
+        }
+    };
+
+    class Benchmark
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Result = BenchmarkStatistics;
+
+    private:
+        BenchmarkSettings settings;
+
+    public:
+        explicit Benchmark(const BenchmarkSettings &settings = BenchmarkSettings())
+            : settings(settings)
+        {}
+
+        const BenchmarkSettings &getSettings() const
+        {
+            return settings;
+        }
+
+        // Runs scenario repeatedly, each call counting as operationsPerRun
+        // operations, until the confidence target or a limit is reached.
+        template<typename Scenario>
+        BenchmarkStatistics run(Scenario scenario, std::size_t operationsPerRun) const
+        {
+            return run([]() {}, scenario, operationsPerRun);
+        }
+
+        // As above, but calls setup before every run without timing it. The
+        // time budget covers setup too, so expensive setups end early.
+        template<typename Setup, typename Scenario>
+        BenchmarkStatistics run(Setup setup, Scenario scenario, std::size_t operationsPerRun) const
+        {
+            for (std::size_t i = 0; i < settings.warmupRuns; i++)
+            {
+                setup();
+                scenario();
+            }
+
+            PerfCounters counters(settings.hardwareCounters);
+            PerfSample hardware;
+
+            std::vector<double> samples;
+            Clock::time_point measuringStart = Clock::now();
+
+            while (samples.size() < settings.maxRuns)
+            {
+                setup();
+                clobberMemory();
+
+                counters.start();
+                Clock::time_point start = Clock::now();
+                scenario();
+                clobberMemory();
+                Clock::time_point stop = Clock::now();
+                counters.stop();
+
+                hardware += counters.read();
+                samples.push_back(std::chrono::duration<double>(stop - start).count());
+
+                if (samples.size() < settings.minRuns)
+                    continue;
+
+                if (relativeErrorOf(samples) <= settings.targetRelativeError)
+                    break;
+
+                if (Clock::now() - measuringStart >= settings.timeBudget)
+                    break;
+            }
+
+            BenchmarkStatistics statistics = summarize(samples, operationsPerRun);
+            if (!samples.empty())
+            {
+                hardware /= samples.size();
+                statistics.hardware = hardware;
+            }
+            return statistics;
+        }
+
+        // Two-sided 95% critical value of Student's t distribution.
+        static double studentT95(double degreesOfFreedom)
+        {
+            static const double tValues[] = {12.706, 4.303, 3.182, 2.776, 2.571,
+                                             2.447, 2.365, 2.306, 2.262, 2.228,
+                                             2.201, 2.179, 2.160, 2.145, 2.131,
+                                             2.120, 2.110, 2.101, 2.093, 2.086};
+            if (degreesOfFreedom < 1)
+                return tValues[0];
+            return degreesOfFreedom <= 20 ? tValues[static_cast<std::size_t>(degreesOfFreedom) - 1] : 1.96;
+        }
+
+        // Whether hardware counters can be opened here, and why not if not.
+        static std::string hardwareCountersStatus()
+        {
+            return PerfCounters().getStatus();
+        }
+
+        static BenchmarkStatistics summarize(std::vector<double> samples, std::size_t operationsPerRun)
+        {
+            BenchmarkStatistics statistics;
+            statistics.runs = samples.size();
+            statistics.operationsPerRun = operationsPerRun;
+
+            if (samples.empty())
+                return statistics;
+
+            std::sort(samples.begin(), samples.end());
+
+            statistics.mean = meanOf(samples);
+            statistics.stddev = stddevOf(samples, statistics.mean);
+            statistics.median = percentileOf(samples, 0.5);
+            statistics.p10 = percentileOf(samples, 0.1);
+            statistics.p90 = percentileOf(samples, 0.9);
+            statistics.relativeError = relativeErrorOf(samples);
+
+            return statistics;
+        }
+
+        static void printHeader(std::ostream &out, const std::string &title)
+        {
+            out << '\n' << title << ":\n";
+            out << std::left << std::setw(22) << "container"
+                << std::right << std::setw(12) << "median"
+                << std::setw(12) << "p10"
+                << std::setw(12) << "p90"
+                << std::setw(12) << "stddev"
+                << std::setw(14) << "ops/s"
+                << std::setw(8) << "runs" << '\n';
+        }
+
+        static void printRow(std::ostream &out, const std::string &label, const BenchmarkStatistics &statistics,
+                             const std::string &note = "")
+        {
+            out << std::left << std::setw(22) << label
+                << std::right << std::setw(12) << formatSeconds(statistics.median)
+                << std::setw(12) << formatSeconds(statistics.p10)
+                << std::setw(12) << formatSeconds(statistics.p90)
+                << std::setw(12) << formatSeconds(statistics.stddev)
+                << std::setw(14) << std::scientific << std::setprecision(3) << statistics.operationsPerSecond()
+                << std::defaultfloat
+                << std::setw(8) << statistics.runs;
+
+            if (!note.empty())
+                out << "  " << note;
+
+            if (statistics.hardware.any())
+                out << "  " << formatHardware(statistics);
+
+            out << '\n';
+        }
+
+        // IPC and per-operation event counts, with n/a for missing events.
+        static std::string formatHardware(const BenchmarkStatistics &statistics)
+        {
+            static const PerfEvent perOperation[] = {PERF_L1D_MISSES, PERF_LLC_MISSES,
+                                                     PERF_DTLB_MISSES, PERF_BRANCH_MISSES};
+            const PerfSample &hardware = statistics.hardware;
+            char buffer[64];
+            std::string result;
+
+            if (hardware.available[PERF_CYCLES] && hardware.available[PERF_INSTRUCTIONS])
+                std::snprintf(buffer, sizeof(buffer), "IPC %.2f", hardware.ipc());
+            else
+                std::snprintf(buffer, sizeof(buffer), "IPC n/a");
+            result += buffer;
+
+            for (PerfEvent event : perOperation)
+            {
+                if (hardware.available[event])
+                    std::snprintf(buffer, sizeof(buffer), ", %s/op %.3f",
+                                  perfEventName(event), statistics.hardwarePerOperation(event));
+                else
+                    std::snprintf(buffer, sizeof(buffer), ", %s/op n/a", perfEventName(event));
+                result += buffer;
+            }
+
+            return result;
+        }
+
+        static std::string formatSeconds(double seconds)
+        {
+            static const char *units[] = {"s", "ms", "us", "ns"};
+            std::size_t unit = 0;
+
+            while (unit < 3 && seconds != 0 && std::fabs(seconds) < 1)
+            {
+                seconds *= 1000;
+                unit++;
+            }
+
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.3f %s", seconds, units[unit]);
+            return buffer;
+        }
+
+        static std::string formatBytes(double bytes)
+        {
+            static const char *units[] = {"B", "KiB", "MiB", "GiB"};
+            std::size_t unit = 0;
+
+            while (unit < 3 && bytes >= 1024)
+            {
+                bytes /= 1024;
+                unit++;
+            }
+
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.4g %s", bytes, units[unit]);
+            return buffer;
+        }
+
+    private:
+        static double meanOf(const std::vector<double> &samples)
+        {
+            double sum = 0;
+            for (double sample : samples)
+                sum += sample;
+            return sum / samples.size();
+        }
+
+        static double stddevOf(const std::vector<double> &samples, double mean)
+        {
+            if (samples.size() < 2)
+                return 0;
+
+            double sum = 0;
+            for (double sample : samples)
+                sum += (sample - mean) * (sample - mean);
+            return std::sqrt(sum / (samples.size() - 1));
+        }
+
+        // Expects sorted samples; interpolates between closest ranks.
+        static double percentileOf(const std::vector<double> &samples, double fraction)
+        {
+            double position = fraction * (samples.size() - 1);
+            std::size_t lower = static_cast<std::size_t>(position);
+            std::size_t upper = std::min(lower + 1, samples.size() - 1);
+            double weight = position - lower;
+
+            return samples[lower] * (1 - weight) + samples[upper] * weight;
+        }
+
+        // Half-width of the 95% confidence interval of the mean, relative to
+        // the mean, using Student's t for small sample counts.
+        static double relativeErrorOf(const std::vector<double> &samples)
+        {
+            if (samples.size() < 2)
+                return 1;
+
+            double t = studentT95(samples.size() - 1);
+
+            double mean = meanOf(samples);
+            if (mean <= 0)
+                return 0;
+
+            return t * stddevOf(samples, mean) / std::sqrt(samples.size()) / mean;
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_BENCHMARK_H
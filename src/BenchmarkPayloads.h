@@ -0,0 +1,210 @@
+#ifndef AISDI_LINEAR_BENCHMARKPAYLOADS_H
+#define AISDI_LINEAR_BENCHMARKPAYLOADS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "OperationCountingObject.h"
+
+namespace aisdi
+{
+
+    // A payload describes an element type for the benchmarks: how to make
+    // the i-th element and how to fold an element into a checksum, so that
+    // reads cannot be optimized away.
+
+    template<typename T>
+    struct NumberPayload
+    {
+        using value_type = T;
+
+        static value_type make(std::size_t i)
+        {
+            return static_cast<value_type>(i);
+        }
+
+        static std::size_t checksum(const value_type &value)
+        {
+            return static_cast<std::size_t>(value);
+        }
+    };
+
+    struct Int32Payload : NumberPayload<std::int32_t>
+    {
+        static const char *name() { return "int32_t"; }
+    };
+
+    struct LongLongPayload : NumberPayload<long long>
+    {
+        static const char *name() { return "long long"; }
+    };
+
+    // Short enough for the small string optimization of common libraries.
+    struct ShortStringPayload
+    {
+        using value_type = std::string;
+
+        static const char *name() { return "std::string (SSO)"; }
+
+        static value_type make(std::size_t i)
+        {
+            return std::to_string(i % 1000000);
+        }
+
+        static std::size_t checksum(const value_type &value)
+        {
+            return value.size() + static_cast<unsigned char>(value[0]);
+        }
+    };
+
+    // Long enough to always live on the heap.
+    struct LongStringPayload
+    {
+        using value_type = std::string;
+
+        static const char *name() { return "std::string (heap)"; }
+
+        static value_type make(std::size_t i)
+        {
+            return std::string(48, static_cast<char>('a' + i % 26)) + std::to_string(i);
+        }
+
+        static std::size_t checksum(const value_type &value)
+        {
+            return value.size() + static_cast<unsigned char>(value[0]);
+        }
+    };
+
+    template<std::size_t Bytes>
+    struct Blob
+    {
+        unsigned char bytes[Bytes];
+    };
+
+    template<std::size_t Bytes>
+    struct BlobPayload
+    {
+        using value_type = Blob<Bytes>;
+
+        static const char *name()
+        {
+            static const std::string name = std::to_string(Bytes) + "-byte POD";
+            return name.c_str();
+        }
+
+        static value_type make(std::size_t i)
+        {
+            value_type value;
+            std::memset(value.bytes, static_cast<int>(i & 0xff), Bytes);
+            return value;
+        }
+
+        static std::size_t checksum(const value_type &value)
+        {
+            return value.bytes[0] + value.bytes[Bytes - 1];
+        }
+    };
+
+    struct CountingObjectPayload
+    {
+        using value_type = OperationCountingObject;
+
+        static const char *name() { return "OperationCountingObject"; }
+
+        static value_type make(std::size_t i)
+        {
+            return value_type(static_cast<int>(i));
+        }
+
+        static std::size_t checksum(const value_type &value)
+        {
+            return static_cast<std::size_t>(static_cast<int>(value));
+        }
+    };
+
+    struct ObjectCounts
+    {
+        std::size_t constructions = 0;
+        std::size_t copies = 0;
+        std::size_t moves = 0;
+    };
+
+    // Wraps an element and counts its constructions, copies and moves
+    // (assignments included), whatever the wrapped type is.
+    template<typename T>
+    class Counted
+    {
+        T value;
+
+    public:
+        explicit Counted(T value_ = T())
+            : value(std::move(value_))
+        {
+            counts().constructions++;
+        }
+
+        Counted(const Counted &other)
+            : value(other.value)
+        {
+            counts().constructions++;
+            counts().copies++;
+        }
+
+        // noexcept as T's, so that containers choose moves over copies
+        // exactly as they would for T itself.
+        Counted(Counted &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : value(std::move(other.value))
+        {
+            counts().constructions++;
+            counts().moves++;
+        }
+
+        Counted &operator=(const Counted &other)
+        {
+            value = other.value;
+            counts().copies++;
+            return *this;
+        }
+
+        Counted &operator=(Counted &&other) noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+            value = std::move(other.value);
+            counts().moves++;
+            return *this;
+        }
+
+        const T &get() const
+        {
+            return value;
+        }
+
+        static ObjectCounts &counts()
+        {
+            static ObjectCounts instance;
+            return instance;
+        }
+    };
+
+    template<typename Payload>
+    struct CountedPayload
+    {
+        using value_type = Counted<typename Payload::value_type>;
+
+        static value_type make(std::size_t i)
+        {
+            return value_type(Payload::make(i));
+        }
+
+        static std::size_t checksum(const value_type &value)
+        {
+            return Payload::checksum(value.get());
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_BENCHMARKPAYLOADS_H
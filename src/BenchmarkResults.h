@@ -0,0 +1,535 @@
+#ifndef AISDI_LINEAR_BENCHMARKRESULTS_H
+#define AISDI_LINEAR_BENCHMARKRESULTS_H
+
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+#include "AllocationTracker.h"
+#include "Benchmark.h"
+#include "BenchmarkPayloads.h"
+#include "LatencyHistogram.h"
+
+// Filled in by the build; see src/CMakeLists.txt.
+#ifndef AISDI_GIT_SHA
+#define AISDI_GIT_SHA "unknown"
+#endif
+
+#ifndef AISDI_BUILD_FLAGS
+#define AISDI_BUILD_FLAGS "unknown"
+#endif
+
+namespace aisdi
+{
+
+    // Where and how a set of results was produced.
+    struct BenchmarkMetadata
+    {
+        std::string host;
+        std::string compiler;
+        std::string flags;
+        std::string gitSha;
+
+        static BenchmarkMetadata current()
+        {
+            BenchmarkMetadata metadata;
+            metadata.host = hostName();
+            metadata.compiler = compilerName();
+            metadata.flags = AISDI_BUILD_FLAGS;
+            metadata.gitSha = AISDI_GIT_SHA;
+            return metadata;
+        }
+
+    private:
+        static std::string hostName()
+        {
+#ifdef __unix__
+            char buffer[256] = {};
+            if (gethostname(buffer, sizeof(buffer) - 1) == 0)
+                return buffer;
+#endif
+            return "unknown";
+        }
+
+        static std::string compilerName()
+        {
+#if defined(__clang__)
+            return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+            return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+            return "unknown";
+#endif
+        }
+    };
+
+    struct BenchmarkRecord
+    {
+        std::string operation;
+        std::string container;
+        std::string type;
+        std::size_t size = 0;
+        BenchmarkStatistics statistics;
+        ObjectCounts counts;
+        AllocationStatistics allocations;
+        LatencySummary latency;
+    };
+
+    // Results of one benchmark invocation, written and read back as JSON or
+    // CSV. Both formats carry the same fields; CSV repeats the metadata on
+    // every row so that rows can be concatenated across files.
+    class BenchmarkResults
+    {
+    public:
+        BenchmarkMetadata metadata;
+        std::vector<BenchmarkRecord> records;
+
+        void add(const BenchmarkRecord &record)
+        {
+            records.push_back(record);
+        }
+
+        void writeJson(std::ostream &out) const
+        {
+            out << "{\n"
+                << "  \"host\": " << quoteJson(metadata.host) << ",\n"
+                << "  \"compiler\": " << quoteJson(metadata.compiler) << ",\n"
+                << "  \"flags\": " << quoteJson(metadata.flags) << ",\n"
+                << "  \"gitSha\": " << quoteJson(metadata.gitSha) << ",\n"
+                << "  \"results\": [";
+
+            for (std::size_t i = 0; i < records.size(); i++)
+            {
+                std::vector<std::pair<std::string, std::string>> row = fieldsOf(records[i]);
+
+                out << (i == 0 ? "\n" : ",\n") << "    {";
+                for (std::size_t j = 0; j < row.size(); j++)
+                {
+                    bool text = j < TEXT_FIELDS;
+                    out << (j == 0 ? "" : ", ") << quoteJson(row[j].first) << ": "
+                        << (text ? quoteJson(row[j].second) : row[j].second);
+                }
+                out << "}";
+            }
+
+            out << "\n  ]\n}\n";
+        }
+
+        void writeCsv(std::ostream &out) const
+        {
+            std::vector<std::pair<std::string, std::string>> header = fieldsOf(BenchmarkRecord());
+
+            out << "host,compiler,flags,gitSha";
+            for (const auto &field : header)
+                out << ',' << field.first;
+            out << '\n';
+
+            for (const BenchmarkRecord &record : records)
+            {
+                out << quoteCsv(metadata.host) << ',' << quoteCsv(metadata.compiler) << ','
+                    << quoteCsv(metadata.flags) << ',' << quoteCsv(metadata.gitSha);
+                for (const auto &field : fieldsOf(record))
+                    out << ',' << quoteCsv(field.second);
+                out << '\n';
+            }
+        }
+
+        // Reads either format, telling them apart by the first character.
+        static BenchmarkResults read(std::istream &in)
+        {
+            std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            std::size_t first = text.find_first_not_of(" \t\r\n");
+
+            if (first != std::string::npos && text[first] == '{')
+                return readJson(text);
+            return readCsv(text);
+        }
+
+    private:
+        // The leading fields of a row are text, the rest are numbers.
+        static const std::size_t TEXT_FIELDS = 3;
+
+        using Fields = std::map<std::string, std::string>;
+
+        static std::vector<std::pair<std::string, std::string>> fieldsOf(const BenchmarkRecord &record)
+        {
+            const BenchmarkStatistics &statistics = record.statistics;
+            std::vector<std::pair<std::string, std::string>> fields = {
+                {"operation", record.operation},
+                {"container", record.container},
+                {"type", record.type},
+                {"n", std::to_string(record.size)},
+                {"runs", std::to_string(statistics.runs)},
+                {"operationsPerRun", std::to_string(statistics.operationsPerRun)},
+                {"mean", number(statistics.mean)},
+                {"median", number(statistics.median)},
+                {"p10", number(statistics.p10)},
+                {"p90", number(statistics.p90)},
+                {"stddev", number(statistics.stddev)},
+                {"relativeError", number(statistics.relativeError)},
+                {"nsPerOperation", number(statistics.nanosecondsPerOperation())},
+                {"constructions", std::to_string(record.counts.constructions)},
+                {"copies", std::to_string(record.counts.copies)},
+                {"moves", std::to_string(record.counts.moves)},
+                {"allocations", std::to_string(record.allocations.allocations)},
+                {"deallocations", std::to_string(record.allocations.deallocations)},
+                {"requestedBytes", std::to_string(record.allocations.requestedBytes)},
+                {"usableBytes", std::to_string(record.allocations.usableBytes)},
+                {"liveBytes", std::to_string(record.allocations.liveBytes)},
+                {"peakLiveBytes", std::to_string(record.allocations.peakLiveBytes)},
+                {"latencyMeanNs", number(record.latency.mean)},
+                {"latencyP50Ns", number(record.latency.p50)},
+                {"latencyP99Ns", number(record.latency.p99)},
+                {"latencyP999Ns", number(record.latency.p999)},
+                {"latencyP9999Ns", number(record.latency.p9999)},
+                {"latencyMaxNs", number(record.latency.max)}
+            };
+
+            // Hardware events per run; null when not counted.
+            for (int event = 0; event < PERF_EVENT_COUNT; event++)
+                fields.push_back({hardwareField(static_cast<PerfEvent>(event)),
+                                  statistics.hardware.available[event]
+                                  ? number(statistics.hardware.values[event]) : "null"});
+
+            return fields;
+        }
+
+        static BenchmarkRecord recordOf(const Fields &fields)
+        {
+            BenchmarkRecord record;
+            record.operation = textOf(fields, "operation");
+            record.container = textOf(fields, "container");
+            record.type = textOf(fields, "type");
+            record.size = static_cast<std::size_t>(numberOf(fields, "n"));
+
+            BenchmarkStatistics &statistics = record.statistics;
+            statistics.runs = static_cast<std::size_t>(numberOf(fields, "runs"));
+            statistics.operationsPerRun = static_cast<std::size_t>(numberOf(fields, "operationsPerRun"));
+            statistics.mean = statisticOf(fields, "mean");
+            statistics.median = statisticOf(fields, "median");
+            statistics.p10 = statisticOf(fields, "p10");
+            statistics.p90 = statisticOf(fields, "p90");
+            statistics.stddev = statisticOf(fields, "stddev");
+            statistics.relativeError = statisticOf(fields, "relativeError");
+
+            record.counts.constructions = static_cast<std::size_t>(numberOf(fields, "constructions"));
+            record.counts.copies = static_cast<std::size_t>(numberOf(fields, "copies"));
+            record.counts.moves = static_cast<std::size_t>(numberOf(fields, "moves"));
+
+            record.allocations.allocations = static_cast<std::size_t>(numberOf(fields, "allocations"));
+            record.allocations.deallocations = static_cast<std::size_t>(numberOf(fields, "deallocations"));
+            record.allocations.requestedBytes = static_cast<std::size_t>(numberOf(fields, "requestedBytes"));
+            record.allocations.usableBytes = static_cast<std::size_t>(numberOf(fields, "usableBytes"));
+            record.allocations.liveBytes = static_cast<long long>(numberOf(fields, "liveBytes"));
+            record.allocations.peakLiveBytes = static_cast<long long>(numberOf(fields, "peakLiveBytes"));
+
+            record.latency.count = record.size;
+            record.latency.mean = statisticOf(fields, "latencyMeanNs");
+            record.latency.p50 = statisticOf(fields, "latencyP50Ns");
+            record.latency.p99 = statisticOf(fields, "latencyP99Ns");
+            record.latency.p999 = statisticOf(fields, "latencyP999Ns");
+            record.latency.p9999 = statisticOf(fields, "latencyP9999Ns");
+            record.latency.max = statisticOf(fields, "latencyMaxNs");
+
+            for (int event = 0; event < PERF_EVENT_COUNT; event++)
+            {
+                Fields::const_iterator field = fields.find(hardwareField(static_cast<PerfEvent>(event)));
+                if (field == fields.end() || field->second == "null" || field->second.empty())
+                    continue;
+                statistics.hardware.values[event] = std::strtod(field->second.c_str(), nullptr);
+                statistics.hardware.available[event] = true;
+            }
+
+            return record;
+        }
+
+        static std::string hardwareField(PerfEvent event)
+        {
+            static const char *names[PERF_EVENT_COUNT] = {
+                "cycles", "instructions", "l1dMisses", "llcMisses", "dtlbMisses", "branchMisses"
+            };
+            return names[event];
+        }
+
+        static std::string textOf(const Fields &fields, const std::string &name)
+        {
+            Fields::const_iterator field = fields.find(name);
+            return field == fields.end() ? std::string() : field->second;
+        }
+
+        static double numberOf(const Fields &fields, const std::string &name)
+        {
+            Fields::const_iterator field = fields.find(name);
+            return field == fields.end() ? 0 : std::strtod(field->second.c_str(), nullptr);
+        }
+
+        // Like numberOf, but reads null back as NaN rather than 0.
+        static double statisticOf(const Fields &fields, const std::string &name)
+        {
+            Fields::const_iterator field = fields.find(name);
+            return field != fields.end() && field->second == "null"
+                   ? std::numeric_limits<double>::quiet_NaN() : numberOf(fields, name);
+        }
+
+        // null for NaN and infinities, which JSON cannot represent.
+        static std::string number(double value)
+        {
+            if (!std::isfinite(value))
+                return "null";
+
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+            return buffer;
+        }
+
+        static std::string quoteJson(const std::string &text)
+        {
+            std::string quoted = "\"";
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                    quoted += '\\';
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    quoted += buffer;
+                    continue;
+                }
+                quoted += c;
+            }
+            return quoted + "\"";
+        }
+
+        static std::string quoteCsv(const std::string &text)
+        {
+            if (text.find_first_of(",\"\n") == std::string::npos)
+                return text;
+
+            std::string quoted = "\"";
+            for (char c : text)
+            {
+                if (c == '"')
+                    quoted += '"';
+                quoted += c;
+            }
+            return quoted + "\"";
+        }
+
+        static BenchmarkResults readCsv(const std::string &text)
+        {
+            BenchmarkResults results;
+            std::vector<std::vector<std::string>> rows = splitCsv(text);
+            if (rows.empty())
+                return results;
+
+            const std::vector<std::string> &header = rows[0];
+            for (std::size_t i = 1; i < rows.size(); i++)
+            {
+                Fields fields;
+                for (std::size_t j = 0; j < header.size() && j < rows[i].size(); j++)
+                    fields[header[j]] = rows[i][j];
+
+                results.metadata.host = textOf(fields, "host");
+                results.metadata.compiler = textOf(fields, "compiler");
+                results.metadata.flags = textOf(fields, "flags");
+                results.metadata.gitSha = textOf(fields, "gitSha");
+                results.add(recordOf(fields));
+            }
+
+            return results;
+        }
+
+        static std::vector<std::vector<std::string>> splitCsv(const std::string &text)
+        {
+            std::vector<std::vector<std::string>> rows;
+            std::vector<std::string> row;
+            std::string field;
+            bool quoted = false;
+
+            for (std::size_t i = 0; i < text.size(); i++)
+            {
+                char c = text[i];
+
+                if (quoted)
+                {
+                    if (c == '"' && i + 1 < text.size() && text[i + 1] == '"')
+                        field += text[++i];
+                    else if (c == '"')
+                        quoted = false;
+                    else
+                        field += c;
+                }
+                else if (c == '"')
+                    quoted = true;
+                else if (c == ',')
+                {
+                    row.push_back(field);
+                    field.clear();
+                }
+                else if (c == '\n')
+                {
+                    row.push_back(field);
+                    field.clear();
+                    rows.push_back(row);
+                    row.clear();
+                }
+                else if (c != '\r')
+                    field += c;
+            }
+
+            if (!field.empty() || !row.empty())
+            {
+                row.push_back(field);
+                rows.push_back(row);
+            }
+
+            return rows;
+        }
+
+        // Reads exactly what writeJson produces: an object of string fields
+        // plus a "results" array of flat objects.
+        class JsonReader
+        {
+            const std::string &text;
+            std::size_t position = 0;
+
+        public:
+            explicit JsonReader(const std::string &text)
+                : text(text)
+            {}
+
+            BenchmarkResults read()
+            {
+                BenchmarkResults results;
+                Fields metadata;
+
+                expect('{');
+                while (!consume('}'))
+                {
+                    std::string key = readString();
+                    expect(':');
+
+                    if (key == "results")
+                        readRecords(results);
+                    else
+                        metadata[key] = readScalar();
+
+                    consume(',');
+                }
+
+                results.metadata.host = textOf(metadata, "host");
+                results.metadata.compiler = textOf(metadata, "compiler");
+                results.metadata.flags = textOf(metadata, "flags");
+                results.metadata.gitSha = textOf(metadata, "gitSha");
+                return results;
+            }
+
+        private:
+            void readRecords(BenchmarkResults &results)
+            {
+                expect('[');
+                while (!consume(']'))
+                {
+                    Fields fields;
+                    expect('{');
+                    while (!consume('}'))
+                    {
+                        std::string key = readString();
+                        expect(':');
+                        fields[key] = readScalar();
+                        consume(',');
+                    }
+                    results.add(recordOf(fields));
+                    consume(',');
+                }
+            }
+
+            std::string readScalar()
+            {
+                skipWhitespace();
+                if (position < text.size() && text[position] == '"')
+                    return readString();
+
+                std::size_t start = position;
+                while (position < text.size() && std::string(",}] \t\r\n").find(text[position]) == std::string::npos)
+                    position++;
+                return text.substr(start, position - start);
+            }
+
+            std::string readString()
+            {
+                expect('"');
+                std::string result;
+                while (position < text.size() && text[position] != '"')
+                {
+                    char c = text[position++];
+                    if (c != '\\' || position >= text.size())
+                    {
+                        result += c;
+                        continue;
+                    }
+
+                    c = text[position++];
+                    if (c == 'u' && position + 4 <= text.size())
+                    {
+                        result += static_cast<char>(std::strtol(text.substr(position, 4).c_str(), nullptr, 16));
+                        position += 4;
+                    }
+                    else
+                        result += c == 'n' ? '\n' : c == 't' ? '\t' : c;
+                }
+                expect('"');
+                return result;
+            }
+
+            bool consume(char expected)
+            {
+                skipWhitespace();
+                if (position < text.size() && text[position] == expected)
+                {
+                    position++;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(char expected)
+            {
+                if (!consume(expected))
+                    throw std::runtime_error(std::string("malformed benchmark JSON: expected '")
+                                             + expected + "' at offset " + std::to_string(position));
+            }
+
+            void skipWhitespace()
+            {
+                while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position])))
+                    position++;
+            }
+        };
+
+        static BenchmarkResults readJson(const std::string &text)
+        {
+            return JsonReader(text).read();
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_BENCHMARKRESULTS_H
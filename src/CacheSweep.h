@@ -0,0 +1,268 @@
+#ifndef AISDI_LINEAR_CACHESWEEP_H
+#define AISDI_LINEAR_CACHESWEEP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "Benchmark.h"
+#include "BenchmarkPayloads.h"
+#include "BenchmarkResults.h"
+#include "OperationMatrix.h"
+
+namespace aisdi
+{
+
+    struct CacheLevel
+    {
+        unsigned level;
+        std::string type;
+        std::size_t bytes;
+
+        std::string name() const
+        {
+            return "L" + std::to_string(level) + (type == "Data" ? "d" : "");
+        }
+    };
+
+    // The data and unified caches of the first CPU, as Linux describes them
+    // in sysfs, smallest first. Empty where sysfs is not available.
+    class CacheHierarchy
+    {
+        std::vector<CacheLevel> levels;
+
+    public:
+        static CacheHierarchy detect()
+        {
+            CacheHierarchy hierarchy;
+
+            for (int index = 0; ; index++)
+            {
+                const std::string directory = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+                std::string level, type, size;
+                if (!readLine(directory + "level", level) || !readLine(directory + "type", type)
+                    || !readLine(directory + "size", size))
+                    break;
+
+                if (type == "Instruction")
+                    continue;
+
+                hierarchy.levels.push_back({static_cast<unsigned>(std::stoul(level)), type, parseSize(size)});
+            }
+
+            std::sort(hierarchy.levels.begin(), hierarchy.levels.end(),
+                      [](const CacheLevel &a, const CacheLevel &b) { return a.bytes < b.bytes; });
+            return hierarchy;
+        }
+
+        const std::vector<CacheLevel> &getLevels() const
+        {
+            return levels;
+        }
+
+        bool isEmpty() const
+        {
+            return levels.empty();
+        }
+
+        // Sizes such as "48K" or "32M".
+        static std::size_t parseSize(const std::string &text)
+        {
+            std::size_t end = 0;
+            std::size_t bytes = std::stoul(text, &end);
+
+            if (end < text.size())
+            {
+                switch (text[end])
+                {
+                    case 'K': return bytes << 10;
+                    case 'M': return bytes << 20;
+                    case 'G': return bytes << 30;
+                    default: break;
+                }
+            }
+            return bytes;
+        }
+
+    private:
+        static bool readLine(const std::string &path, std::string &line)
+        {
+            std::ifstream in(path);
+            return static_cast<bool>(std::getline(in, line)) && !line.empty();
+        }
+    };
+
+    // Measures iteration, middle insert and middle erase per element
+    // against the working set in bytes, with sizes chosen on both sides of
+    // every cache level: half of it, all of it and twice it. The working
+    // set is the heap a contender holds per element, measured with
+    // AllocationTracker, so node and string overheads count. Insert and
+    // erase are reported per element shifted or walked past (size/2).
+    template<typename Payload>
+    class CacheSweep
+    {
+        using Measurement = std::function<BenchmarkStatistics(const Benchmark &, Operation, std::size_t)>;
+
+        struct Contender
+        {
+            std::string name;
+            Measurement measure;
+            double bytesPerElement;
+        };
+
+        struct Point
+        {
+            std::size_t workingSet;
+            const Contender *contender;
+            std::size_t size;
+            double nanosecondsPerElement;
+        };
+
+        Benchmark benchmark;
+        CacheHierarchy hierarchy;
+        std::size_t maxBytes;
+        std::vector<Contender> contenders;
+
+    public:
+        static const std::size_t BAR_WIDTH = 40;
+
+        CacheSweep(const CacheHierarchy &hierarchy, std::size_t maxBytes, const BenchmarkSettings &settings)
+            : benchmark(settings.relaxed()), hierarchy(hierarchy), maxBytes(maxBytes)
+        {}
+
+        template<template<typename> class Collection>
+        void addContender(const std::string &name)
+        {
+            using Scenario = OperationScenario<Collection<typename Payload::value_type>, Payload>;
+
+            contenders.push_back({name, [](const Benchmark &benchmark, Operation operation, std::size_t size) {
+                return Scenario(size).perform(operation, benchmark);
+            }, bytesPerElement<Collection<typename Payload::value_type>>()});
+        }
+
+        void run(std::ostream &out, BenchmarkResults *results = nullptr) const
+        {
+            static const Operation operations[] = {Operation::ITERATE, Operation::MIDDLE_INSERT, Operation::ERASE};
+            const std::vector<std::size_t> workingSets = chooseWorkingSets();
+
+            for (Operation operation : operations)
+            {
+                std::vector<Point> points;
+
+                for (std::size_t workingSet : workingSets)
+                {
+                    for (const Contender &contender : contenders)
+                    {
+                        std::size_t size = std::max<std::size_t>(
+                                2, static_cast<std::size_t>(workingSet / contender.bytesPerElement));
+                        BenchmarkStatistics statistics = contender.measure(benchmark, operation, size);
+                        double elements = operation == Operation::ITERATE ? 1 : size / 2.0;
+
+                        points.push_back({workingSet, &contender, size,
+                                          statistics.nanosecondsPerOperation() / elements});
+
+                        if (results)
+                            record(*results, operation, contender.name, size, statistics);
+                    }
+                }
+
+                print(out, operation, points);
+            }
+        }
+
+    private:
+        template<typename Collection>
+        static double bytesPerElement()
+        {
+            static const std::size_t PROBE_SIZE = 4096;
+
+            AllocationScope allocations;
+            Collection collection;
+            for (std::size_t i = 0; i < PROBE_SIZE; i++)
+                collection.append(Payload::make(i));
+
+            double bytes = static_cast<double>(allocations.snapshot().liveBytes) / PROBE_SIZE;
+            // Without the replacement operator new nothing is counted.
+            return bytes > 0 ? bytes : sizeof(typename Payload::value_type);
+        }
+
+        std::vector<std::size_t> chooseWorkingSets() const
+        {
+            std::vector<std::size_t> workingSets;
+
+            for (const CacheLevel &level : hierarchy.getLevels())
+                for (std::size_t workingSet : {level.bytes / 2, level.bytes, level.bytes * 2})
+                    if (workingSet <= maxBytes)
+                        workingSets.push_back(workingSet);
+
+            if (workingSets.empty())
+                workingSets.push_back(std::min<std::size_t>(maxBytes, 1 << 20));
+
+            std::sort(workingSets.begin(), workingSets.end());
+            workingSets.erase(std::unique(workingSets.begin(), workingSets.end()), workingSets.end());
+            return workingSets;
+        }
+
+        // One row per working set and contender, with a bar scaled to the
+        // slowest row; a rule marks where each cache level is exceeded.
+        void print(std::ostream &out, Operation operation, const std::vector<Point> &points) const
+        {
+            double slowest = 0;
+            for (const Point &point : points)
+                slowest = std::max(slowest, point.nanosecondsPerElement);
+
+            out << '\n' << operationName(operation) << ", " << Payload::name() << ", ns per element "
+                << (operation == Operation::ITERATE ? "visited" : "shifted or walked past") << ":\n";
+            out << std::right << std::setw(12) << "working set" << std::setw(20) << "container"
+                << std::setw(12) << "n" << std::setw(10) << "ns" << '\n';
+
+            std::size_t nextLevel = 0;
+            const std::vector<CacheLevel> &levels = hierarchy.getLevels();
+
+            for (const Point &point : points)
+            {
+                while (nextLevel < levels.size() && point.workingSet > levels[nextLevel].bytes)
+                {
+                    out << "  ---- " << levels[nextLevel].name() << " "
+                        << Benchmark::formatBytes(levels[nextLevel].bytes) << " ----\n";
+                    nextLevel++;
+                }
+
+                std::size_t bar = slowest > 0
+                                  ? static_cast<std::size_t>(point.nanosecondsPerElement / slowest * BAR_WIDTH + 0.5) : 0;
+
+                char ns[32];
+                std::snprintf(ns, sizeof(ns), "%.3f", point.nanosecondsPerElement);
+                out << std::right << std::setw(12) << Benchmark::formatBytes(point.workingSet)
+                    << std::setw(20) << point.contender->name << std::setw(12) << point.size
+                    << std::setw(10) << ns << "  " << std::string(std::max<std::size_t>(bar, 1), '#') << '\n';
+            }
+
+            for (; nextLevel < levels.size(); nextLevel++)
+                out << "  ---- " << levels[nextLevel].name() << " "
+                    << Benchmark::formatBytes(levels[nextLevel].bytes) << " (beyond the sweep) ----\n";
+        }
+
+        static void record(BenchmarkResults &results, Operation operation, const std::string &container,
+                           std::size_t size, const BenchmarkStatistics &statistics)
+        {
+            BenchmarkRecord record;
+            record.operation = std::string("cache sweep: ") + operationName(operation);
+            record.container = container;
+            record.type = Payload::name();
+            record.size = size;
+            record.statistics = statistics;
+            results.add(record);
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_CACHESWEEP_H
@@ -0,0 +1,208 @@
+#ifndef AISDI_LINEAR_CONCURRENTVECTOR_H
+#define AISDI_LINEAR_CONCURRENTVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "SegmentIndex.h"
+
+namespace aisdi
+{
+
+    // Append-only array that any number of threads may append to and read
+    // from at once. Instead of reallocating like Vector, it adds segments
+    // that are never moved (see SegmentIndex), so an element keeps its
+    // address for the life of the collection.
+    //
+    // append() claims an index with fetch_add, makes sure the segment
+    // exists, with a CAS that one of the racing threads wins, constructs
+    // the element and sets its bit in the segment's ready bitmap. Readers
+    // may use any index that append() returned to them, or that
+    // isReady() confirms.
+    template<typename Type>
+    class ConcurrentVector
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = Type;
+        using reference = Type &;
+        using const_reference = const Type &;
+
+    private:
+        using Position = SegmentIndex<5>;
+
+        static const unsigned MAX_SEGMENTS = Position::MAX_SEGMENTS;
+        static const unsigned READY_BITS = 64;
+
+        using Storage = typename std::aligned_storage<sizeof(Type), alignof(Type)>::type;
+
+        struct Segment
+        {
+            Storage *elements;
+            std::atomic<std::uint64_t> *ready;
+
+            explicit Segment(size_type capacity)
+                : elements(new Storage[capacity]),
+                  ready(new std::atomic<std::uint64_t>[(capacity + READY_BITS - 1) / READY_BITS])
+            {
+                for (size_type i = 0; i < (capacity + READY_BITS - 1) / READY_BITS; i++)
+                    ready[i].store(0, std::memory_order_relaxed);
+            }
+
+            ~Segment()
+            {
+                delete [] elements;
+                delete [] ready;
+            }
+        };
+
+        std::atomic<Segment*> segments[MAX_SEGMENTS];
+        std::atomic<size_type> reserved;
+
+    public:
+        ConcurrentVector()
+            : reserved(0)
+        {
+            for (std::atomic<Segment*> &segment : segments)
+                segment.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ConcurrentVector(const ConcurrentVector &) = delete;
+        ConcurrentVector &operator=(const ConcurrentVector &) = delete;
+
+        // Must not race with appends.
+        ~ConcurrentVector()
+        {
+            const size_type count = reserved.load(std::memory_order_acquire);
+
+            for (size_type i = 0; i < count; i++)
+                if (isReady(i))
+                    (*this)[i].~Type();
+
+            for (std::atomic<Segment*> &segment : segments)
+                delete segment.load(std::memory_order_acquire);
+        }
+
+        // Number of indices handed out; elements of the latest ones may
+        // still be under construction in other threads.
+        size_type getSize() const
+        {
+            return reserved.load(std::memory_order_acquire);
+        }
+
+        bool isEmpty() const
+        {
+            return getSize() == 0;
+        }
+
+        // Allocates the segments up to capacity elements ahead of time, so
+        // that appends below it never allocate.
+        void reserve(size_type capacity)
+        {
+            if (capacity == 0)
+                return;
+
+            for (unsigned segment = 0; segment <= Position::locate(capacity - 1).segment; segment++)
+                segmentAt(segment);
+        }
+
+        // Returns the index of the new element.
+        size_type append(const Type &item)
+        {
+            return emplace(item);
+        }
+
+        size_type append(Type &&item)
+        {
+            return emplace(std::move(item));
+        }
+
+        // Whether the element at index is fully constructed; once true,
+        // its value is visible to the calling thread.
+        bool isReady(size_type index) const
+        {
+            if (index >= getSize())
+                return false;
+
+            Position position = Position::locate(index);
+            Segment *segment = segments[position.segment].load(std::memory_order_acquire);
+            if (segment == nullptr)
+                return false;
+
+            return (segment->ready[position.offset / READY_BITS].load(std::memory_order_acquire)
+                    >> (position.offset % READY_BITS) & 1) != 0;
+        }
+
+        // For indices that are ready; not checked.
+        reference operator[](size_type index)
+        {
+            Position position = Position::locate(index);
+            Segment *segment = segments[position.segment].load(std::memory_order_relaxed);
+            return *reinterpret_cast<Type*>(&segment->elements[position.offset]);
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return const_cast<ConcurrentVector&>(*this)[index];
+        }
+
+        reference at(size_type index)
+        {
+            throwIfNotReady<std::out_of_range>(index, "element is not in the collection");
+            return (*this)[index];
+        }
+
+        const_reference at(size_type index) const
+        {
+            throwIfNotReady<std::out_of_range>(index, "element is not in the collection");
+            return (*this)[index];
+        }
+
+    private:
+        template<typename Value>
+        size_type emplace(Value &&item)
+        {
+            const size_type index = reserved.fetch_add(1, std::memory_order_relaxed);
+            Position position = Position::locate(index);
+            Segment *segment = segmentAt(position.segment);
+
+            new (&segment->elements[position.offset]) Type(std::forward<Value>(item));
+            segment->ready[position.offset / READY_BITS].fetch_or(
+                    std::uint64_t(1) << (position.offset % READY_BITS), std::memory_order_release);
+
+            return index;
+        }
+
+        // Every thread that finds the segment missing allocates one, the
+        // first to publish it wins and the others free theirs.
+        Segment *segmentAt(unsigned index)
+        {
+            Segment *segment = segments[index].load(std::memory_order_acquire);
+            if (segment != nullptr)
+                return segment;
+
+            Segment *allocated = new Segment(Position::capacityOf(index));
+            if (segments[index].compare_exchange_strong(segment, allocated, std::memory_order_acq_rel,
+                                                        std::memory_order_acquire))
+                return allocated;
+
+            delete allocated;
+            return segment;
+        }
+
+        template <typename Exception>
+        void throwIfNotReady(size_type index, const char *message) const
+        {
+            if (!isReady(index))
+                throw Exception(message);
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_CONCURRENTVECTOR_H
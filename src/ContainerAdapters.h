@@ -0,0 +1,211 @@
+#ifndef AISDI_LINEAR_CONTAINERADAPTERS_H
+#define AISDI_LINEAR_CONTAINERADAPTERS_H
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <utility>
+#include <vector>
+
+namespace aisdi
+{
+
+    // Gives any standard iterator the operator+ and operator- the
+    // benchmarks use for positional seeks; on non-random-access iterators
+    // they step one element at a time, as aisdi::LinkedList does.
+    template<typename BaseIterator>
+    class AdaptedIterator
+    {
+        BaseIterator base;
+
+        template<typename>
+        friend class AdaptedIterator;
+
+    public:
+        using iterator_category = typename std::iterator_traits<BaseIterator>::iterator_category;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+        using difference_type = typename std::iterator_traits<BaseIterator>::difference_type;
+        using pointer = typename std::iterator_traits<BaseIterator>::pointer;
+        using reference = typename std::iterator_traits<BaseIterator>::reference;
+
+        explicit AdaptedIterator(BaseIterator base = BaseIterator())
+            : base(base)
+        {}
+
+        // Lets an iterator convert to a const_iterator.
+        template<typename OtherIterator>
+        AdaptedIterator(const AdaptedIterator<OtherIterator> &other)
+            : base(other.base)
+        {}
+
+        const BaseIterator &getBase() const
+        {
+            return base;
+        }
+
+        reference operator*() const
+        {
+            return *base;
+        }
+
+        pointer operator->() const
+        {
+            return &*base;
+        }
+
+        AdaptedIterator &operator++()
+        {
+            ++base;
+            return *this;
+        }
+
+        AdaptedIterator operator++(int)
+        {
+            return AdaptedIterator(base++);
+        }
+
+        AdaptedIterator &operator--()
+        {
+            --base;
+            return *this;
+        }
+
+        AdaptedIterator operator--(int)
+        {
+            return AdaptedIterator(base--);
+        }
+
+        AdaptedIterator operator+(difference_type d) const
+        {
+            return AdaptedIterator(std::next(base, d));
+        }
+
+        AdaptedIterator operator-(difference_type d) const
+        {
+            return AdaptedIterator(std::prev(base, d));
+        }
+
+        bool operator==(const AdaptedIterator &other) const
+        {
+            return base == other.base;
+        }
+
+        bool operator!=(const AdaptedIterator &other) const
+        {
+            return base != other.base;
+        }
+    };
+
+    // Presents a standard sequence container through the aisdi collection
+    // interface, so that the benchmarks can measure the standard library
+    // with the very same scenarios.
+    template<typename Sequence>
+    class StdSequenceAdapter
+    {
+    public:
+        using value_type = typename Sequence::value_type;
+        using size_type = std::size_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using iterator = AdaptedIterator<typename Sequence::iterator>;
+        using const_iterator = AdaptedIterator<typename Sequence::const_iterator>;
+
+    private:
+        Sequence sequence;
+
+    public:
+        bool isEmpty() const
+        {
+            return sequence.empty();
+        }
+
+        size_type getSize() const
+        {
+            return sequence.size();
+        }
+
+        void append(const value_type &item)
+        {
+            sequence.push_back(item);
+        }
+
+        // insert at begin() is push_front for list and deque, and the
+        // only way to prepend to a vector.
+        void prepend(const value_type &item)
+        {
+            sequence.insert(sequence.begin(), item);
+        }
+
+        void insert(const const_iterator &insertPosition, const value_type &item)
+        {
+            sequence.insert(insertPosition.getBase(), item);
+        }
+
+        value_type popFirst()
+        {
+            value_type value = std::move(sequence.front());
+            sequence.erase(sequence.begin());
+            return value;
+        }
+
+        value_type popLast()
+        {
+            value_type value = std::move(sequence.back());
+            sequence.pop_back();
+            return value;
+        }
+
+        void erase(const const_iterator &position)
+        {
+            sequence.erase(position.getBase());
+        }
+
+        void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+        {
+            sequence.erase(firstIncluded.getBase(), lastExcluded.getBase());
+        }
+
+        iterator begin()
+        {
+            return iterator(sequence.begin());
+        }
+
+        iterator end()
+        {
+            return iterator(sequence.end());
+        }
+
+        const_iterator cbegin() const
+        {
+            return const_iterator(sequence.cbegin());
+        }
+
+        const_iterator cend() const
+        {
+            return const_iterator(sequence.cend());
+        }
+
+        const_iterator begin() const
+        {
+            return cbegin();
+        }
+
+        const_iterator end() const
+        {
+            return cend();
+        }
+    };
+
+    template<typename Type>
+    using StdVector = StdSequenceAdapter<std::vector<Type>>;
+
+    template<typename Type>
+    using StdList = StdSequenceAdapter<std::list<Type>>;
+
+    template<typename Type>
+    using StdDeque = StdSequenceAdapter<std::deque<Type>>;
+
+}
+
+#endif // AISDI_LINEAR_CONTAINERADAPTERS_H
@@ -0,0 +1,351 @@
+#ifndef AISDI_LINEAR_CROSSOVERFINDER_H
+#define AISDI_LINEAR_CROSSOVERFINDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Vector.h"
+#include "LinkedList.h"
+#include "Benchmark.h"
+#include "BenchmarkPayloads.h"
+#include "BenchmarkResults.h"
+#include "SequenceSelection.h"
+
+namespace aisdi
+{
+
+    inline const std::vector<AccessPattern> &allAccessPatterns()
+    {
+        static const std::vector<AccessPattern> patterns = {
+            AccessPattern::FRONT_INSERT, AccessPattern::INSERT_NEAR_FRONT, AccessPattern::MIDDLE_INSERT,
+            AccessPattern::INSERT_NEAR_BACK, AccessPattern::ERASE_WHILE_ITERATING
+        };
+        return patterns;
+    }
+
+    inline const char *accessPatternName(AccessPattern pattern)
+    {
+        switch (pattern)
+        {
+            case AccessPattern::FRONT_INSERT: return "front insert";
+            case AccessPattern::INSERT_NEAR_FRONT: return "insert at p = 0.1";
+            case AccessPattern::MIDDLE_INSERT: return "insert at p = 0.5";
+            case AccessPattern::INSERT_NEAR_BACK: return "insert at p = 0.9";
+            case AccessPattern::ERASE_WHILE_ITERATING: return "erase while iterating";
+        }
+        return "unknown";
+    }
+
+    inline const char *accessPatternIdentifier(AccessPattern pattern)
+    {
+        switch (pattern)
+        {
+            case AccessPattern::FRONT_INSERT: return "FRONT_INSERT";
+            case AccessPattern::INSERT_NEAR_FRONT: return "INSERT_NEAR_FRONT";
+            case AccessPattern::MIDDLE_INSERT: return "MIDDLE_INSERT";
+            case AccessPattern::INSERT_NEAR_BACK: return "INSERT_NEAR_BACK";
+            case AccessPattern::ERASE_WHILE_ITERATING: return "ERASE_WHILE_ITERATING";
+        }
+        return "unknown";
+    }
+
+    // Insert position as a fraction of the size; front insert uses prepend.
+    inline double insertFraction(AccessPattern pattern)
+    {
+        switch (pattern)
+        {
+            case AccessPattern::INSERT_NEAR_FRONT: return 0.1;
+            case AccessPattern::MIDDLE_INSERT: return 0.5;
+            case AccessPattern::INSERT_NEAR_BACK: return 0.9;
+            default: return 0;
+        }
+    }
+
+    // Erases the element at position and leaves position at the next one.
+    // Iterators to other nodes survive an erase from a list.
+    template<typename Collection>
+    void eraseAndAdvance(Collection &collection, typename Collection::iterator &position)
+    {
+        typename Collection::iterator next = position;
+        ++next;
+        collection.erase(position);
+        position = next;
+    }
+
+    // A Vector shifts the next element into the erased slot.
+    template<typename Type>
+    void eraseAndAdvance(Vector<Type> &collection, typename Vector<Type>::iterator &position)
+    {
+        const std::size_t index = position.calculateIndex();
+        collection.erase(position);
+        position = collection.begin() + index;
+    }
+
+    // Applies a pattern to collections of exactly size elements. Small
+    // sizes are measured on many copies at once and large ones with a few
+    // operations per copy, so that every run is long enough to time while
+    // the size changes by under 2% (by one element below 64).
+    template<typename Collection, typename Payload>
+    class CrossoverScenario
+    {
+        static constexpr std::size_t ELEMENTS_PER_RUN = 100000;
+        static constexpr std::size_t MAX_COPIES = 1000;
+        static constexpr std::size_t MAX_OPERATIONS_PER_COPY = 64;
+
+        std::size_t size;
+        Collection prototype;
+        std::vector<Collection> targets;
+
+    public:
+        explicit CrossoverScenario(std::size_t size)
+            : size(size),
+              targets(std::max<std::size_t>(1, std::min(MAX_COPIES, ELEMENTS_PER_RUN / size)))
+        {
+            for (std::size_t i = 0; i < size; i++)
+                prototype.append(Payload::make(i));
+        }
+
+        BenchmarkStatistics measure(AccessPattern pattern, const Benchmark &benchmark)
+        {
+            auto restore = [this]() {
+                for (Collection &target : targets)
+                    target = prototype;
+            };
+
+            if (pattern == AccessPattern::ERASE_WHILE_ITERATING)
+            {
+                // Per element visited.
+                return benchmark.run(restore, [this]() {
+                    for (Collection &target : targets)
+                    {
+                        bool erase = true;
+                        for (auto position = target.begin(); position != target.end(); erase = !erase)
+                        {
+                            if (erase)
+                                eraseAndAdvance(target, position);
+                            else
+                                ++position;
+                        }
+                    }
+                }, targets.size() * size);
+            }
+
+            const std::size_t operations = std::max<std::size_t>(1, std::min(MAX_OPERATIONS_PER_COPY, size / 64));
+            const double fraction = insertFraction(pattern);
+
+            if (pattern == AccessPattern::FRONT_INSERT)
+            {
+                return benchmark.run(restore, [this, operations]() {
+                    for (Collection &target : targets)
+                        for (std::size_t i = 0; i < operations; i++)
+                            target.prepend(Payload::make(i));
+                }, targets.size() * operations);
+            }
+
+            return benchmark.run(restore, [this, operations, fraction]() {
+                for (Collection &target : targets)
+                    for (std::size_t i = 0; i < operations; i++)
+                    {
+                        const std::size_t index = static_cast<std::size_t>(fraction * target.getSize());
+                        target.insert(target.begin() + index, Payload::make(i));
+                    }
+            }, targets.size() * operations);
+        }
+    };
+
+    template<typename Collection, typename Payload>
+    constexpr std::size_t CrossoverScenario<Collection, Payload>::ELEMENTS_PER_RUN;
+    template<typename Collection, typename Payload>
+    constexpr std::size_t CrossoverScenario<Collection, Payload>::MAX_COPIES;
+    template<typename Collection, typename Payload>
+    constexpr std::size_t CrossoverScenario<Collection, Payload>::MAX_OPERATIONS_PER_COPY;
+
+    // Finds, for every access pattern and element size, the collection size
+    // from which LinkedList beats Vector: sizes double from 1 until the
+    // winner flips, then the last interval is bisected (geometrically) down
+    // to a ratio of 1 + PRECISION. Only the first lasting flip is found; the
+    // comparison uses medians, so a crossover is as precise as the noise at
+    // sizes where both are close allows. Element sizes are compile-time,
+    // so they are a fixed ladder rather than bisected.
+    class CrossoverFinder
+    {
+    public:
+        static constexpr double PRECISION = 0.1;
+
+    private:
+        // Whether the list is faster at a size; records both measurements.
+        using Comparison = std::function<bool(const Benchmark &, AccessPattern, std::size_t, BenchmarkResults *)>;
+
+        struct ElementSize
+        {
+            std::size_t bytes;
+            std::string name;
+            Comparison listIsFaster;
+        };
+
+        std::size_t maxSize;
+        Benchmark benchmark;
+        std::vector<ElementSize> elementSizes;
+        std::vector<CrossoverThreshold> thresholds;
+
+    public:
+        // Searching takes many short measurements, so the given settings
+        // are relaxed.
+        CrossoverFinder(std::size_t maxSize, const BenchmarkSettings &settings)
+            : maxSize(maxSize),
+              benchmark(settings.relaxed())
+        {}
+
+        template<typename Payload>
+        void addElementSize()
+        {
+            elementSizes.push_back({sizeof(typename Payload::value_type), Payload::name(),
+                                    [](const Benchmark &benchmark, AccessPattern pattern, std::size_t size,
+                                       BenchmarkResults *results) {
+                BenchmarkStatistics vector = CrossoverScenario<Vector<typename Payload::value_type>, Payload>(size)
+                        .measure(pattern, benchmark);
+                BenchmarkStatistics list = CrossoverScenario<LinkedList<typename Payload::value_type>, Payload>(size)
+                        .measure(pattern, benchmark);
+
+                if (results)
+                {
+                    record(*results, pattern, "vector", Payload::name(), size, vector);
+                    record(*results, pattern, "list", Payload::name(), size, list);
+                }
+                return list.median < vector.median;
+            }});
+        }
+
+        void run(std::ostream &out, BenchmarkResults *results = nullptr)
+        {
+            thresholds.clear();
+
+            for (AccessPattern pattern : allAccessPatterns())
+            {
+                out << '\n' << accessPatternName(pattern) << ", LinkedList vs Vector up to " << maxSize << ":\n";
+                out << std::left << std::setw(22) << "element" << std::right << std::setw(8) << "bytes"
+                    << std::setw(16) << "list from n" << std::setw(10) << "probes" << '\n';
+
+                for (const ElementSize &elementSize : elementSizes)
+                {
+                    std::size_t probes = 0;
+                    std::size_t listFrom = search(pattern, elementSize, probes, results);
+                    thresholds.push_back({pattern, elementSize.bytes, listFrom});
+
+                    out << std::left << std::setw(22) << elementSize.name << std::right
+                        << std::setw(8) << elementSize.bytes << std::setw(16) << describe(listFrom)
+                        << std::setw(10) << probes << '\n';
+                }
+            }
+        }
+
+        const std::vector<CrossoverThreshold> &getThresholds() const
+        {
+            return thresholds;
+        }
+
+        // Writes the thresholds found as CrossoverTable.h, which
+        // SequenceSelection.h includes.
+        void writeTable(std::ostream &out) const
+        {
+            out << "#ifndef AISDI_LINEAR_CROSSOVERTABLE_H\n"
+                << "#define AISDI_LINEAR_CROSSOVERTABLE_H\n\n"
+                << "// Generated by \"aisdiLinear crossover " << maxSize << "\" on "
+                << BenchmarkMetadata::current().host << "; regenerate rather than edit.\n\n"
+                << "namespace aisdi\n{\n\n"
+                << "    constexpr CrossoverThreshold crossoverThresholds[] = {\n";
+
+            for (const CrossoverThreshold &threshold : thresholds)
+            {
+                out << "        {AccessPattern::" << accessPatternIdentifier(threshold.pattern)
+                    << ", " << threshold.elementBytes << ", ";
+                if (threshold.listFromSize == CrossoverThreshold::NEVER)
+                    out << "CrossoverThreshold::NEVER";
+                else if (threshold.listFromSize == CrossoverThreshold::ALWAYS)
+                    out << "CrossoverThreshold::ALWAYS";
+                else
+                    out << threshold.listFromSize;
+                out << "},\n";
+            }
+
+            out << "    };\n\n}\n\n#endif // AISDI_LINEAR_CROSSOVERTABLE_H\n";
+        }
+
+    private:
+        std::size_t search(AccessPattern pattern, const ElementSize &elementSize, std::size_t &probes,
+                           BenchmarkResults *results) const
+        {
+            auto listIsFaster = [&](std::size_t size) {
+                probes++;
+                return elementSize.listIsFaster(benchmark, pattern, size, results);
+            };
+
+            // While doubling, a win only counts if it holds at twice the size
+            // too, so that noise where both are close cannot end the search.
+            auto listWinsFrom = [&](std::size_t size) {
+                return listIsFaster(size) && (size >= maxSize || listIsFaster(std::min(2 * size, maxSize)));
+            };
+
+            if (listWinsFrom(1))
+                return CrossoverThreshold::ALWAYS;
+
+            // Vector is faster at lower, the list at upper.
+            std::size_t lower = 1;
+            std::size_t upper = 0;
+
+            for (std::size_t size = 2; upper == 0; size *= 2)
+            {
+                size = std::min(size, maxSize);
+                if (listWinsFrom(size))
+                    upper = size;
+                else if (size == maxSize)
+                    return CrossoverThreshold::NEVER;
+                else
+                    lower = size;
+            }
+
+            while (upper > lower + 1 && upper > lower * (1 + PRECISION))
+            {
+                std::size_t middle = static_cast<std::size_t>(std::sqrt(static_cast<double>(lower) * upper));
+                middle = std::max(lower + 1, std::min(upper - 1, middle));
+
+                if (listIsFaster(middle))
+                    upper = middle;
+                else
+                    lower = middle;
+            }
+
+            return upper;
+        }
+
+        static std::string describe(std::size_t listFrom)
+        {
+            if (listFrom == CrossoverThreshold::ALWAYS)
+                return "always";
+            if (listFrom == CrossoverThreshold::NEVER)
+                return "never";
+            return std::to_string(listFrom);
+        }
+
+        static void record(BenchmarkResults &results, AccessPattern pattern, const std::string &container,
+                           const std::string &type, std::size_t size, const BenchmarkStatistics &statistics)
+        {
+            BenchmarkRecord record;
+            record.operation = std::string("crossover: ") + accessPatternName(pattern);
+            record.container = container;
+            record.type = type;
+            record.size = size;
+            record.statistics = statistics;
+            results.add(record);
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_CROSSOVERFINDER_H
@@ -0,0 +1,34 @@
+#ifndef AISDI_LINEAR_CROSSOVERTABLE_H
+#define AISDI_LINEAR_CROSSOVERTABLE_H
+
+// Generated by "aisdiLinear crossover 100000" on vm; regenerate rather than edit.
+
+namespace aisdi
+{
+
+    constexpr CrossoverThreshold crossoverThresholds[] = {
+        {AccessPattern::FRONT_INSERT, 8, 256},
+        {AccessPattern::FRONT_INSERT, 32, 10},
+        {AccessPattern::FRONT_INSERT, 128, 6},
+        {AccessPattern::FRONT_INSERT, 512, CrossoverThreshold::ALWAYS},
+        {AccessPattern::INSERT_NEAR_FRONT, 8, CrossoverThreshold::NEVER},
+        {AccessPattern::INSERT_NEAR_FRONT, 32, 23},
+        {AccessPattern::INSERT_NEAR_FRONT, 128, 4},
+        {AccessPattern::INSERT_NEAR_FRONT, 512, CrossoverThreshold::ALWAYS},
+        {AccessPattern::MIDDLE_INSERT, 8, CrossoverThreshold::NEVER},
+        {AccessPattern::MIDDLE_INSERT, 32, CrossoverThreshold::NEVER},
+        {AccessPattern::MIDDLE_INSERT, 128, 1722},
+        {AccessPattern::MIDDLE_INSERT, 512, CrossoverThreshold::ALWAYS},
+        {AccessPattern::INSERT_NEAR_BACK, 8, CrossoverThreshold::NEVER},
+        {AccessPattern::INSERT_NEAR_BACK, 32, CrossoverThreshold::NEVER},
+        {AccessPattern::INSERT_NEAR_BACK, 128, CrossoverThreshold::NEVER},
+        {AccessPattern::INSERT_NEAR_BACK, 512, CrossoverThreshold::ALWAYS},
+        {AccessPattern::ERASE_WHILE_ITERATING, 8, 663},
+        {AccessPattern::ERASE_WHILE_ITERATING, 32, 48},
+        {AccessPattern::ERASE_WHILE_ITERATING, 128, 42},
+        {AccessPattern::ERASE_WHILE_ITERATING, 512, 2},
+    };
+
+}
+
+#endif // AISDI_LINEAR_CROSSOVERTABLE_H
@@ -0,0 +1,681 @@
+#ifndef AISDI_LINEAR_DEQUE_H
+#define AISDI_LINEAR_DEQUE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace aisdi
+{
+
+    namespace detail
+    {
+        constexpr std::size_t roundDownToPowerOfTwo(std::size_t n, std::size_t power = 1)
+        {
+            return power * 2 > n ? power : roundDownToPowerOfTwo(n, power * 2);
+        }
+
+        // Elements per block: roughly one page worth, but never fewer than 16.
+        constexpr std::size_t dequeBlockSize(std::size_t elementSize)
+        {
+            return elementSize * 16 > 4096 ? 16 : roundDownToPowerOfTwo(4096 / elementSize);
+        }
+    }
+
+    // Segmented double-ended queue. Elements live in fixed-size blocks that
+    // are never moved; only the block map (an array of block pointers) is
+    // reallocated, so growth at either end is O(1) and costs no element copies.
+    template<typename Type>
+    class Deque
+    {
+    public:
+        class ConstIterator;
+        class Iterator;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type *;
+        using reference = Type &;
+        using const_pointer = const Type *;
+        using const_reference = const Type &;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        static constexpr size_type BLOCK_SIZE = detail::dequeBlockSize(sizeof(Type));
+
+    private:
+        static const size_type MIN_MAP_CAPACITY = 8;
+
+        pointer *blocks;
+        size_type mapCapacity;
+        size_type firstBlock;
+        size_type blockCount;
+        size_type start;
+        size_type size;
+
+    public:
+        explicit Deque()
+            : blocks(nullptr),
+              mapCapacity(0),
+              firstBlock(0),
+              blockCount(0),
+              start(0),
+              size(0)
+        {}
+
+        Deque(std::initializer_list<Type> l)
+            : Deque()
+        {
+            copyFrom(l);
+        }
+
+        Deque(const Deque &other)
+            : Deque()
+        {
+            copyFrom(other);
+        }
+
+        Deque(Deque &&other) noexcept
+            : Deque()
+        {
+            moveFrom(other);
+        }
+
+        ~Deque()
+        {
+            destroyElements();
+            releaseStorage();
+        }
+
+        Deque &operator=(const Deque &other)
+        {
+            if (this == &other)
+                return *this;
+
+            destroyElements();
+            copyFrom(other);
+
+            return *this;
+        }
+
+        Deque &operator=(Deque &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            destroyElements();
+            releaseStorage();
+            moveFrom(other);
+
+            return *this;
+        }
+
+        bool isEmpty() const
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const
+        {
+            return size;
+        }
+
+        reference operator[](size_type index)
+        {
+            return *slotAt(index);
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return *slotAt(index);
+        }
+
+        void append(const Type &item)
+        {
+            reserveBack();
+            new (slotAt(size)) Type(item);
+            size++;
+        }
+
+        void prepend(const Type &item)
+        {
+            reserveFront();
+            new (slotAt(-1)) Type(item);
+            start--;
+            size++;
+        }
+
+        void insert(const const_iterator &insertPosition, const Type &item)
+        {
+            size_type insertIndex = insertPosition.getIndex();
+
+            if (insertIndex < size / 2)
+                insertShiftingFront(insertIndex, item);
+            else
+                insertShiftingBack(insertIndex, item);
+
+            size++;
+        }
+
+        Type popFirst()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popFirst when collection is empty");
+
+            Type value = std::move(*slotAt(0));
+            destroyFront(1);
+            return value;
+        }
+
+        Type popLast()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popLast when collection is empty");
+
+            Type value = std::move(*slotAt(size - 1));
+            destroyBack(1);
+            return value;
+        }
+
+        void erase(const const_iterator &position)
+        {
+            throwIfCollectionEmpty<std::out_of_range>(
+                    "cannot erase from empty collection");
+
+            throwIfIteratorEqualsEnd<std::out_of_range>(
+                    position,
+                    "cannot erase end");
+
+            eraseIndexRange(position.getIndex(), position.getIndex() + 1);
+        }
+
+        void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+        {
+            if (firstIncluded == lastExcluded)
+                return;
+
+            eraseIndexRange(firstIncluded.getIndex(), lastExcluded.getIndex());
+        }
+
+        iterator begin()
+        {
+            return Iterator(this, 0);
+        }
+
+        iterator end()
+        {
+            return Iterator(this, size);
+        }
+
+        const_iterator cbegin() const
+        {
+            return ConstIterator(this, 0);
+        }
+
+        const_iterator cend() const
+        {
+            return ConstIterator(this, size);
+        }
+
+        const_iterator begin() const
+        {
+            return cbegin();
+        }
+
+        const_iterator end() const
+        {
+            return cend();
+        }
+
+    private:
+        pointer slotAt(difference_type index) const
+        {
+            size_type position = start + index;
+            return blocks[firstBlock + position / BLOCK_SIZE] + position % BLOCK_SIZE;
+        }
+
+        void insertShiftingFront(size_type insertIndex, const Type &item)
+        {
+            reserveFront();
+
+            if (insertIndex == 0)
+            {
+                new (slotAt(-1)) Type(item);
+                start--;
+                return;
+            }
+
+            new (slotAt(-1)) Type(std::move(*slotAt(0)));
+            start--;
+
+            for (size_type i = 1; i < insertIndex; i++)
+                *slotAt(i) = std::move(*slotAt(i + 1));
+
+            *slotAt(insertIndex) = item;
+        }
+
+        void insertShiftingBack(size_type insertIndex, const Type &item)
+        {
+            reserveBack();
+
+            if (insertIndex == size)
+            {
+                new (slotAt(size)) Type(item);
+                return;
+            }
+
+            new (slotAt(size)) Type(std::move(*slotAt(size - 1)));
+
+            for (size_type i = size - 1; i > insertIndex; i--)
+                *slotAt(i) = std::move(*slotAt(i - 1));
+
+            *slotAt(insertIndex) = item;
+        }
+
+        // Closes the gap by moving whichever side of it is shorter.
+        void eraseIndexRange(size_type firstIncluded, size_type lastExcluded)
+        {
+            size_type count = lastExcluded - firstIncluded;
+
+            if (firstIncluded < size - lastExcluded)
+            {
+                for (size_type i = firstIncluded; i > 0; i--)
+                    *slotAt(i - 1 + count) = std::move(*slotAt(i - 1));
+
+                destroyFront(count);
+            }
+            else
+            {
+                for (size_type i = lastExcluded; i < size; i++)
+                    *slotAt(i - count) = std::move(*slotAt(i));
+
+                destroyBack(count);
+            }
+        }
+
+        void destroyFront(size_type count)
+        {
+            for (size_type i = 0; i < count; i++)
+                slotAt(i)->~Type();
+
+            start += count;
+            size -= count;
+
+            while (start >= BLOCK_SIZE)
+            {
+                freeBlock(blocks[firstBlock]);
+                firstBlock++;
+                blockCount--;
+                start -= BLOCK_SIZE;
+            }
+        }
+
+        void destroyBack(size_type count)
+        {
+            for (size_type i = size - count; i < size; i++)
+                slotAt(i)->~Type();
+
+            size -= count;
+
+            while (blockCount * BLOCK_SIZE - (start + size) >= BLOCK_SIZE)
+            {
+                blockCount--;
+                freeBlock(blocks[firstBlock + blockCount]);
+            }
+        }
+
+        void destroyElements()
+        {
+            if (!isEmpty())
+                destroyBack(size);
+        }
+
+        void reserveFront()
+        {
+            if (start > 0)
+                return;
+
+            if (firstBlock == 0)
+                reallocateMap();
+
+            firstBlock--;
+            blocks[firstBlock] = allocateBlock();
+            blockCount++;
+            start += BLOCK_SIZE;
+        }
+
+        void reserveBack()
+        {
+            if (start + size < blockCount * BLOCK_SIZE)
+                return;
+
+            if (firstBlock + blockCount == mapCapacity)
+                reallocateMap();
+
+            blocks[firstBlock + blockCount] = allocateBlock();
+            blockCount++;
+        }
+
+        // Leaves the used blocks centred in a map with room for at least one
+        // more block at each end.
+        void reallocateMap()
+        {
+            size_type newCapacity = 2 * (blockCount + 1);
+            if (newCapacity < MIN_MAP_CAPACITY)
+                newCapacity = MIN_MAP_CAPACITY;
+
+            pointer *newBlocks = new pointer[newCapacity];
+            size_type newFirstBlock = (newCapacity - blockCount) / 2;
+
+            for (size_type i = 0; i < blockCount; i++)
+                newBlocks[newFirstBlock + i] = blocks[firstBlock + i];
+
+            delete [] blocks;
+
+            blocks = newBlocks;
+            mapCapacity = newCapacity;
+            firstBlock = newFirstBlock;
+        }
+
+        pointer allocateBlock()
+        {
+            return static_cast<pointer>(::operator new(BLOCK_SIZE * sizeof(Type)));
+        }
+
+        void freeBlock(pointer block)
+        {
+            ::operator delete(block);
+        }
+
+        void releaseStorage()
+        {
+            for (size_type i = 0; i < blockCount; i++)
+                freeBlock(blocks[firstBlock + i]);
+
+            delete [] blocks;
+
+            blocks = nullptr;
+            mapCapacity = 0;
+            firstBlock = 0;
+            blockCount = 0;
+            start = 0;
+        }
+
+        template<class Collection>
+        void copyFrom(const Collection &collection)
+        {
+            for (auto& el : collection)
+                append(el);
+        }
+
+        void moveFrom(Deque &other)
+        {
+            std::swap(blocks, other.blocks);
+            std::swap(mapCapacity, other.mapCapacity);
+            std::swap(firstBlock, other.firstBlock);
+            std::swap(blockCount, other.blockCount);
+            std::swap(start, other.start);
+            std::swap(size, other.size);
+        }
+
+        template <typename Exception>
+        void throwIfCollectionEmpty(const char *message) const
+        {
+            if (isEmpty())
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfIteratorEqualsEnd(const ConstIterator &iterator, const char *message) const
+        {
+            if (iterator.getIndex() >= size)
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    constexpr typename Deque<Type>::size_type Deque<Type>::BLOCK_SIZE;
+
+    template<typename Type>
+    class Deque<Type>::ConstIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename Deque::value_type;
+        using difference_type = typename Deque::difference_type;
+        using pointer = typename Deque::const_pointer;
+        using reference = typename Deque::const_reference;
+        using size_type = typename Deque::size_type;
+
+        friend class Deque;
+
+    private:
+        const Deque *collection;
+        size_type index;
+
+    public:
+        explicit ConstIterator(const Deque *collection, size_type index)
+            : collection(collection),
+              index(index)
+        {}
+
+        ConstIterator()
+            : collection(nullptr),
+              index(0)
+        {}
+
+        reference operator*() const
+        {
+            throwIfEnd<std::out_of_range>(
+                    "end iterator cannot be dereferenced");
+
+            return *collection->slotAt(index);
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+
+        ConstIterator &operator++()
+        {
+            throwIfEnd<std::out_of_range>(
+                    "cannot increment end iterator");
+
+            index++;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator old = *this;
+            operator++();
+            return old;
+        }
+
+        ConstIterator &operator--()
+        {
+            throwIfBegin<std::out_of_range>(
+                    "cannot decrement begin iterator");
+
+            index--;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator old = *this;
+            operator--();
+            return old;
+        }
+
+        ConstIterator &operator+=(difference_type d)
+        {
+            index += d;
+            return *this;
+        }
+
+        ConstIterator &operator-=(difference_type d)
+        {
+            index -= d;
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type d) const
+        {
+            return ConstIterator(collection, index + d);
+        }
+
+        ConstIterator operator-(difference_type d) const
+        {
+            return ConstIterator(collection, index - d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const ConstIterator &other) const
+        {
+            return collection == other.collection && index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const
+        {
+            return !operator==(other);
+        }
+
+        bool operator<(const ConstIterator &other) const
+        {
+            return index < other.index;
+        }
+
+        bool operator>(const ConstIterator &other) const
+        {
+            return other < *this;
+        }
+
+        bool operator<=(const ConstIterator &other) const
+        {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ConstIterator &other) const
+        {
+            return !(*this < other);
+        }
+
+    protected:
+        size_type getIndex() const
+        {
+            return index;
+        }
+
+        template <typename Exception>
+        void throwIfBegin(const char *message) const
+        {
+            if (index == 0)
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfEnd(const char *message) const
+        {
+            if (index >= collection->getSize())
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    class Deque<Type>::Iterator : public Deque<Type>::ConstIterator
+    {
+    public:
+        using pointer = typename Deque::pointer;
+        using reference = typename Deque::reference;
+        using size_type = typename Deque::size_type;
+
+        explicit Iterator(Deque *collection, size_type index)
+            : ConstIterator(collection, index)
+        {}
+
+        Iterator()
+        {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other)
+        {}
+
+        Iterator &operator++()
+        {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--()
+        {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator &operator+=(difference_type d)
+        {
+            ConstIterator::operator+=(d);
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type d)
+        {
+            ConstIterator::operator-=(d);
+            return *this;
+        }
+
+        Iterator operator+(difference_type d) const
+        {
+            return ConstIterator::operator+(d);
+        }
+
+        Iterator operator-(difference_type d) const
+        {
+            return ConstIterator::operator-(d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return ConstIterator::operator-(other);
+        }
+
+        reference operator*() const
+        {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_DEQUE_H
@@ -0,0 +1,427 @@
+#ifndef AISDI_LINEAR_FORWARDLIST_H
+#define AISDI_LINEAR_FORWARDLIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "NodePool.h"
+
+namespace aisdi
+{
+
+    // Singly linked list meant for FIFO workloads (append at the tail, popFirst
+    // at the head). Nodes carry a single link and no vtable, and the guard node
+    // lives inside the list object, so a node is just `next` plus the value.
+    // With Pooled set, nodes are recycled through a NodePool instead of
+    // going through new/delete on every operation.
+    template<typename Type, bool Pooled = false>
+    class ForwardList
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type *;
+        using reference = Type &;
+        using const_pointer = const Type *;
+        using const_reference = const Type &;
+
+        class ConstIterator;
+        class Iterator;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        struct Node
+        {
+            Node *next;
+
+            explicit Node()
+                : next(nullptr)
+            {}
+        };
+
+        struct ValueNode : public Node
+        {
+            Type value;
+
+            explicit ValueNode(const Type& value)
+                : value(value)
+            {}
+        };
+
+    private:
+        using NodeAllocator = typename std::conditional<Pooled,
+                NodePool<ValueNode>,
+                HeapNodeAllocator<ValueNode>>::type;
+
+        Node head;
+        Node *tail;
+        size_type size;
+        NodeAllocator allocator;
+
+    public:
+        explicit ForwardList()
+            : tail(&head),
+              size(0)
+        {}
+
+        ForwardList(std::initializer_list<Type> l)
+            : ForwardList()
+        {
+            copyFrom(l);
+        }
+
+        ForwardList(const ForwardList &other)
+            : ForwardList()
+        {
+            copyFrom(other);
+        }
+
+        ForwardList(ForwardList &&other) noexcept
+            : ForwardList()
+        {
+            moveFrom(other);
+        }
+
+        ~ForwardList()
+        {
+            deleteList();
+        }
+
+        ForwardList &operator=(const ForwardList &other)
+        {
+            if (this == &other)
+                return *this;
+
+            deleteList();
+            copyFrom(other);
+
+            return *this;
+        }
+
+        ForwardList &operator=(ForwardList &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            deleteList();
+            moveFrom(other);
+
+            return *this;
+        }
+
+        bool isEmpty() const
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const
+        {
+            return size;
+        }
+
+        void append(const Type &item)
+        {
+            linkAfter(tail, allocator.create(item));
+        }
+
+        void prepend(const Type &item)
+        {
+            linkAfter(&head, allocator.create(item));
+        }
+
+        iterator insertAfter(const const_iterator &position, const Type &item)
+        {
+            throwIfIteratorEqualsEnd<std::out_of_range>(
+                    position,
+                    "cannot insert after end iterator");
+
+            ValueNode *nodeToInsert = allocator.create(item);
+            linkAfter(position.getCurrentNode(), nodeToInsert);
+
+            return Iterator(nodeToInsert, this);
+        }
+
+        iterator eraseAfter(const const_iterator &position)
+        {
+            throwIfIteratorEqualsEnd<std::out_of_range>(
+                    position,
+                    "cannot erase after end iterator");
+
+            Node *left = position.getCurrentNode();
+            if (left->next == nullptr)
+                throw std::out_of_range("cannot erase after last element");
+
+            unlinkAfter(left);
+
+            return Iterator(left->next, this);
+        }
+
+        Type popFirst()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popFirst from empty collection");
+
+            ValueNode *first = static_cast<ValueNode*>(head.next);
+            Type result = first->value;
+
+            unlinkAfter(&head);
+
+            return result;
+        }
+
+        iterator beforeBegin()
+        {
+            return Iterator(&head, this);
+        }
+
+        const_iterator cbeforeBegin() const
+        {
+            return ConstIterator(const_cast<Node*>(&head), this);
+        }
+
+        const_iterator beforeBegin() const
+        {
+            return cbeforeBegin();
+        }
+
+        iterator begin()
+        {
+            return Iterator(head.next, this);
+        }
+
+        iterator end()
+        {
+            return Iterator(nullptr, this);
+        }
+
+        const_iterator cbegin() const
+        {
+            return ConstIterator(head.next, this);
+        }
+
+        const_iterator cend() const
+        {
+            return ConstIterator(nullptr, this);
+        }
+
+        const_iterator begin() const
+        {
+            return cbegin();
+        }
+
+        const_iterator end() const
+        {
+            return cend();
+        }
+
+    private:
+        void linkAfter(Node *left, ValueNode *nodeToInsert)
+        {
+            nodeToInsert->next = left->next;
+            left->next = nodeToInsert;
+
+            if (left == tail)
+                tail = nodeToInsert;
+
+            size++;
+        }
+
+        void unlinkAfter(Node *left)
+        {
+            ValueNode *nodeToErase = static_cast<ValueNode*>(left->next);
+            left->next = nodeToErase->next;
+
+            if (nodeToErase == tail)
+                tail = left;
+
+            allocator.destroy(nodeToErase);
+            size--;
+        }
+
+        void deleteList()
+        {
+            for (Node *node = head.next; node != nullptr; )
+            {
+                Node *old = node;
+                node = node->next;
+                allocator.destroy(static_cast<ValueNode*>(old));
+            }
+
+            head.next = nullptr;
+            tail = &head;
+            size = 0;
+        }
+
+        template<class Collection>
+        void copyFrom(const Collection& collection)
+        {
+            for (auto& el : collection)
+                append(el);
+        }
+
+        void moveFrom(ForwardList& other)
+        {
+            if (other.isEmpty())
+                return;
+
+            head.next = other.head.next;
+            tail = other.tail;
+            size = other.size;
+            allocator.swap(other.allocator);
+
+            other.head.next = nullptr;
+            other.tail = &other.head;
+            other.size = 0;
+        }
+
+        template <typename Exception>
+        void throwIfCollectionEmpty(const char *message) const
+        {
+            if (isEmpty())
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfIteratorEqualsEnd(const ConstIterator &iterator, const char *message) const
+        {
+            if (iterator.getCurrentNode() == nullptr)
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type, bool Pooled>
+    class ForwardList<Type, Pooled>::ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename ForwardList::value_type;
+        using difference_type = typename ForwardList::difference_type;
+        using pointer = typename ForwardList::const_pointer;
+        using reference = typename ForwardList::const_reference;
+
+    private:
+        Node *currentNode;
+        const ForwardList *collection;
+
+    public:
+        explicit ConstIterator(Node *node, const ForwardList *collection)
+            : currentNode(node),
+              collection(collection)
+        {}
+
+        ConstIterator()
+            : currentNode(nullptr),
+              collection(nullptr)
+        {}
+
+        reference operator*() const
+        {
+            throwIfEnd<std::out_of_range>(
+                    "end iterator cannot be dereferenced");
+
+            if (currentNode == &collection->head)
+                throw std::out_of_range("before begin iterator cannot be dereferenced");
+
+            return static_cast<ValueNode*>(currentNode)->value;
+        }
+
+        ConstIterator &operator++()
+        {
+            throwIfEnd<std::out_of_range>(
+                    "cannot increment end iterator");
+
+            currentNode = currentNode->next;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator old = *this;
+            operator++();
+            return old;
+        }
+
+        ConstIterator operator+(difference_type d) const
+        {
+            ConstIterator result = *this;
+
+            for (difference_type i = 0; i < d; i++)
+                ++result;
+
+            return result;
+        }
+
+        bool operator==(const ConstIterator &other) const
+        {
+            return currentNode == other.currentNode;
+        }
+
+        bool operator!=(const ConstIterator &other) const
+        {
+            return !operator==(other);
+        }
+
+        friend class ForwardList;
+
+    protected:
+        Node *getCurrentNode() const
+        {
+            return currentNode;
+        }
+
+        template <typename Exception>
+        void throwIfEnd(const char *message) const
+        {
+            if (currentNode == nullptr)
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type, bool Pooled>
+    class ForwardList<Type, Pooled>::Iterator : public ForwardList<Type, Pooled>::ConstIterator
+    {
+    public:
+        using pointer = typename ForwardList::pointer;
+        using reference = typename ForwardList::reference;
+
+        explicit Iterator(Node *currentNode, ForwardList *collection)
+            : ConstIterator(currentNode, collection)
+        {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other)
+        {}
+
+        Iterator &operator++()
+        {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator operator+(difference_type d) const
+        {
+            return ConstIterator::operator+(d);
+        }
+
+        reference operator*() const
+        {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_FORWARDLIST_H
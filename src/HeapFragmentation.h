@@ -0,0 +1,253 @@
+#ifndef AISDI_LINEAR_HEAPFRAGMENTATION_H
+#define AISDI_LINEAR_HEAPFRAGMENTATION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace aisdi
+{
+
+    // How far apart consecutive elements of a collection are in memory,
+    // taken from the element addresses, so from the nodes for a list.
+    struct NodeLocality
+    {
+        std::size_t pairs = 0;
+        // Mean distance in bytes between an element and the next one.
+        double averageStride = 0;
+        // Share of consecutive elements that sit on the same page.
+        double samePageShare = 0;
+
+        static std::size_t pageSize()
+        {
+#ifdef __unix__
+            static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            return size;
+#else
+            return 4096;
+#endif
+        }
+    };
+
+    template<typename Collection>
+    NodeLocality measureLocality(const Collection &collection)
+    {
+        NodeLocality locality;
+        const std::uintptr_t page = NodeLocality::pageSize();
+        double strides = 0;
+        std::size_t samePage = 0;
+
+        auto it = collection.cbegin();
+        if (it == collection.cend())
+            return locality;
+
+        std::uintptr_t previous = reinterpret_cast<std::uintptr_t>(&*it);
+        for (++it; it != collection.cend(); ++it)
+        {
+            std::uintptr_t current = reinterpret_cast<std::uintptr_t>(&*it);
+            strides += current > previous ? current - previous : previous - current;
+            if (current / page == previous / page)
+                samePage++;
+
+            locality.pairs++;
+            previous = current;
+        }
+
+        if (locality.pairs > 0)
+        {
+            locality.averageStride = strides / locality.pairs;
+            locality.samePageShare = static_cast<double>(samePage) / locality.pairs;
+        }
+        return locality;
+    }
+
+    enum class HeapLayout
+    {
+        FRESH,              // appended into a heap with nothing else going on
+        INTERLEAVED,        // other live allocations between the nodes
+        SHUFFLED_FREE_LIST, // nodes reuse blocks freed in random order
+        SHUFFLED_INSERTION  // linked in a random order unlike allocation order
+    };
+
+    inline const std::vector<HeapLayout> &allHeapLayouts()
+    {
+        static const std::vector<HeapLayout> layouts = {
+            HeapLayout::FRESH, HeapLayout::INTERLEAVED,
+            HeapLayout::SHUFFLED_FREE_LIST, HeapLayout::SHUFFLED_INSERTION
+        };
+        return layouts;
+    }
+
+    inline const char *heapLayoutName(HeapLayout layout)
+    {
+        switch (layout)
+        {
+            case HeapLayout::FRESH: return "fresh heap";
+            case HeapLayout::INTERLEAVED: return "interleaved";
+            case HeapLayout::SHUFFLED_FREE_LIST: return "shuffled free list";
+            case HeapLayout::SHUFFLED_INSERTION: return "shuffled insertion";
+        }
+        return "unknown";
+    }
+
+    // Builds a collection of 0..size-1, in order, with its nodes laid out
+    // the way a long-running program would leave them rather than back to
+    // back. Keeps the interleaved allocations alive until the next build,
+    // so that they stay between the nodes while the collection is used.
+    class FragmentedHeap
+    {
+        static const std::size_t MIN_FILLER_BYTES = 16;
+        static const std::size_t MAX_FILLER_BYTES = 256;
+
+        std::vector<std::unique_ptr<char[]>> fillers;
+        std::mt19937_64 random;
+
+    public:
+        explicit FragmentedHeap(std::uint64_t seed = 42)
+            : random(seed)
+        {}
+
+        template<typename Collection>
+        void build(Collection &collection, HeapLayout layout, std::size_t size)
+        {
+            fillers.clear();
+            settle();
+
+            switch (layout)
+            {
+                case HeapLayout::FRESH:
+                    for (std::size_t i = 0; i < size; i++)
+                        collection.append(static_cast<typename Collection::value_type>(i));
+                    return;
+
+                case HeapLayout::INTERLEAVED:
+                    buildInterleaved(collection, size);
+                    return;
+
+                case HeapLayout::SHUFFLED_FREE_LIST:
+                    buildFromShuffledFreeList(collection, size);
+                    return;
+
+                case HeapLayout::SHUFFLED_INSERTION:
+                    buildByShuffledInsertion(collection, size);
+                    return;
+            }
+        }
+
+    private:
+        // Every node is followed by a block of random size, of which half
+        // are freed again: nodes end up among live objects and holes.
+        template<typename Collection>
+        void buildInterleaved(Collection &collection, std::size_t size)
+        {
+            std::uniform_int_distribution<std::size_t> fillerBytes(MIN_FILLER_BYTES, MAX_FILLER_BYTES);
+            fillers.reserve(size);
+
+            for (std::size_t i = 0; i < size; i++)
+            {
+                collection.append(static_cast<typename Collection::value_type>(i));
+                fillers.emplace_back(new char[fillerBytes(random)]);
+            }
+
+            for (std::size_t i = 0; i < fillers.size(); i += 2)
+                fillers[i].reset();
+        }
+
+        // Allocates blocks of the node's size and frees them in random
+        // order; the allocator's free lists then hand them to the nodes in
+        // that order. The block size is taken from a probe node.
+        template<typename Collection>
+        void buildFromShuffledFreeList(Collection &collection, std::size_t size)
+        {
+            const std::size_t nodeBytes = probeNodeBytes<Collection>();
+            std::vector<std::unique_ptr<char[]>> blocks;
+            blocks.reserve(size);
+
+            for (std::size_t i = 0; i < size; i++)
+                blocks.emplace_back(new char[nodeBytes]);
+
+            std::shuffle(blocks.begin(), blocks.end(), random);
+            blocks.clear();
+
+            for (std::size_t i = 0; i < size; i++)
+                collection.append(static_cast<typename Collection::value_type>(i));
+        }
+
+        // Inserts each value before a random earlier one, then reads the
+        // values back in list order so the collection still holds
+        // 0..size-1 in order: list order and allocation order now differ.
+        template<typename Collection>
+        void buildByShuffledInsertion(Collection &collection, std::size_t size)
+        {
+            if (size == 0)
+                return;
+
+            std::vector<typename Collection::iterator> positions;
+            positions.reserve(size);
+            collection.append(0);
+            positions.push_back(collection.begin());
+
+            for (std::size_t i = 1; i < size; i++)
+            {
+                typename Collection::iterator before = positions[random() % positions.size()];
+                collection.insert(before, 0);
+                positions.push_back(before - 1);
+            }
+
+            typename Collection::value_type value = 0;
+            for (typename Collection::value_type &element : collection)
+                element = value++;
+        }
+
+        // Returns freed blocks to the allocator's ordered bins, so that
+        // every layout starts from the same heap whatever came before.
+        // glibc merges its fast bins on malloc_trim; elsewhere a no-op.
+        static void settle()
+        {
+#ifdef __GLIBC__
+            malloc_trim(0);
+#endif
+        }
+
+        // The least distance between the nodes of a small probe, which is
+        // what a node costs the allocator, header included: nodes taken
+        // from the top of the heap lie back to back, recycled ones farther.
+        template<typename Collection>
+        static std::size_t probeNodeBytes()
+        {
+            static const std::size_t PROBE_SIZE = 64;
+            Collection probe;
+            for (std::size_t i = 0; i < PROBE_SIZE; i++)
+                probe.append(static_cast<typename Collection::value_type>(i));
+
+            std::size_t least = static_cast<std::size_t>(-1);
+            auto it = probe.cbegin();
+            std::uintptr_t previous = reinterpret_cast<std::uintptr_t>(&*it);
+            for (++it; it != probe.cend(); ++it)
+            {
+                std::uintptr_t current = reinterpret_cast<std::uintptr_t>(&*it);
+                std::size_t distance = current > previous ? current - previous : previous - current;
+                if (distance > 0)
+                    least = std::min(least, distance);
+                previous = current;
+            }
+
+            // The allocator adds its header back.
+            return least > sizeof(std::size_t) && least < 1024 ? least - sizeof(std::size_t) : 32;
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_HEAPFRAGMENTATION_H
@@ -0,0 +1,226 @@
+#ifndef AISDI_LINEAR_LATENCYHISTOGRAM_H
+#define AISDI_LINEAR_LATENCYHISTOGRAM_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Benchmark.h"
+
+namespace aisdi
+{
+
+    // Timestamps cheap enough to take around every single operation: the
+    // time stamp counter on x86, steady_clock elsewhere. Ticks are
+    // converted to nanoseconds with a rate calibrated once per process.
+    class TickClock
+    {
+    public:
+        static std::uint64_t now()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        static const char *source()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return "rdtsc";
+#else
+            return "steady_clock";
+#endif
+        }
+
+        static double ticksPerNanosecond()
+        {
+            static const double rate = calibrate();
+            return rate;
+        }
+
+        // The least ticks between two back-to-back readings, which every
+        // recorded latency includes.
+        static std::uint64_t overhead()
+        {
+            std::uint64_t least = static_cast<std::uint64_t>(-1);
+            for (int i = 0; i < 1000; i++)
+            {
+                std::uint64_t start = now();
+                std::uint64_t stop = now();
+                if (stop - start < least)
+                    least = stop - start;
+            }
+            return least;
+        }
+
+    private:
+        static double calibrate()
+        {
+            using Clock = std::chrono::steady_clock;
+
+            Clock::time_point start = Clock::now();
+            std::uint64_t startTicks = now();
+            while (Clock::now() - start < std::chrono::milliseconds(20))
+                ;
+            std::uint64_t stopTicks = now();
+            double nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+            return (stopTicks - startTicks) / nanoseconds;
+        }
+    };
+
+    struct LatencySummary
+    {
+        std::size_t count = 0;
+        double mean = 0;
+        double p50 = 0;
+        double p99 = 0;
+        double p999 = 0;
+        double p9999 = 0;
+        double max = 0;
+    };
+
+    // HDR-style histogram: values are bucketed by their power of two, and
+    // each power is split into SUB_BUCKETS linear sub-buckets, so that any
+    // 64-bit value is kept to within 1/SUB_BUCKETS of itself in a fixed
+    // 15 KiB. Recording is a few instructions, cheap enough per operation.
+    class LatencyHistogram
+    {
+        static const unsigned SUB_BUCKET_BITS = 5;
+        static const std::uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static const std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        std::vector<std::uint64_t> counts;
+        std::uint64_t total = 0;
+        std::uint64_t maxValue = 0;
+        double sum = 0;
+
+    public:
+        LatencyHistogram()
+            : counts(BUCKET_COUNT)
+        {}
+
+        void record(std::uint64_t value)
+        {
+            counts[indexOf(value)]++;
+            total++;
+            sum += value;
+            if (value > maxValue)
+                maxValue = value;
+        }
+
+        LatencyHistogram &operator+=(const LatencyHistogram &other)
+        {
+            for (std::size_t i = 0; i < BUCKET_COUNT; i++)
+                counts[i] += other.counts[i];
+            total += other.total;
+            sum += other.sum;
+            if (other.maxValue > maxValue)
+                maxValue = other.maxValue;
+            return *this;
+        }
+
+        std::uint64_t getCount() const
+        {
+            return total;
+        }
+
+        std::uint64_t getMax() const
+        {
+            return maxValue;
+        }
+
+        double getMean() const
+        {
+            return total > 0 ? sum / total : 0;
+        }
+
+        // The highest value that may have been recorded at the given rank;
+        // never above the largest value recorded.
+        std::uint64_t percentile(double fraction) const
+        {
+            if (total == 0)
+                return 0;
+
+            std::uint64_t rank = static_cast<std::uint64_t>(fraction * total + 0.5);
+            if (rank < 1)
+                rank = 1;
+
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BUCKET_COUNT; i++)
+            {
+                seen += counts[i];
+                if (seen >= rank)
+                    return highestOf(i) < maxValue ? highestOf(i) : maxValue;
+            }
+            return maxValue;
+        }
+
+        // In nanoseconds, for values recorded in ticks per nanosecond.
+        LatencySummary summarize(double ticksPerNanosecond = 1) const
+        {
+            LatencySummary summary;
+            summary.count = total;
+            summary.mean = getMean() / ticksPerNanosecond;
+            summary.p50 = percentile(0.5) / ticksPerNanosecond;
+            summary.p99 = percentile(0.99) / ticksPerNanosecond;
+            summary.p999 = percentile(0.999) / ticksPerNanosecond;
+            summary.p9999 = percentile(0.9999) / ticksPerNanosecond;
+            summary.max = maxValue / ticksPerNanosecond;
+            return summary;
+        }
+
+    private:
+        // Values under SUB_BUCKETS have a bucket each; above, a value with
+        // its highest bit at position SUB_BUCKET_BITS + e lands in sub-bucket
+        // (value >> e) of the e-th group.
+        static std::size_t indexOf(std::uint64_t value)
+        {
+            if (value < SUB_BUCKETS)
+                return static_cast<std::size_t>(value);
+
+            unsigned exponent = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+            return exponent * SUB_BUCKETS + static_cast<std::size_t>(value >> exponent);
+        }
+
+        static std::uint64_t highestOf(std::size_t index)
+        {
+            if (index < SUB_BUCKETS)
+                return index;
+
+            unsigned exponent = static_cast<unsigned>(index / SUB_BUCKETS - 1);
+            std::uint64_t subBucket = index % SUB_BUCKETS + SUB_BUCKETS;
+            return ((subBucket + 1) << exponent) - 1;
+        }
+    };
+
+    // Times every single call of operation(i) for i < count.
+    template<typename Operation>
+    LatencyHistogram recordLatencies(std::size_t count, Operation operation)
+    {
+        LatencyHistogram histogram;
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            std::uint64_t start = TickClock::now();
+            clobberMemory();
+            operation(i);
+            clobberMemory();
+            std::uint64_t stop = TickClock::now();
+            histogram.record(stop - start);
+        }
+
+        return histogram;
+    }
+
+}
+
+#endif // AISDI_LINEAR_LATENCYHISTOGRAM_H
@@ -0,0 +1,122 @@
+#ifndef AISDI_LINEAR_MEMORYFOOTPRINT_H
+#define AISDI_LINEAR_MEMORYFOOTPRINT_H
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "BenchmarkPayloads.h"
+#include "BenchmarkResults.h"
+
+namespace aisdi
+{
+
+    // Reports what holding n elements costs each contender: the collection
+    // is built by appending, as a program would, so a Vector's spare
+    // capacity is included. Heap bytes come from AllocationTracker and
+    // include what the elements themselves allocate (e.g. long strings).
+    // Columns: live blocks; bytes requested in total, including buffers
+    // freed while growing; live usable bytes; the same plus estimated malloc
+    // headers; malloc's rounding over the requested sizes; peak live bytes.
+    template<typename Payload>
+    class MemoryFootprint
+    {
+        using Measurement = std::function<AllocationStatistics(std::size_t)>;
+
+        struct Contender
+        {
+            std::string name;
+            Measurement measure;
+        };
+
+        std::vector<std::size_t> sizes;
+        std::vector<Contender> contenders;
+
+    public:
+        explicit MemoryFootprint(const std::vector<std::size_t> &sizes)
+            : sizes(sizes)
+        {}
+
+        template<template<typename> class Collection>
+        void addContender(const std::string &name)
+        {
+            contenders.push_back({name, [](std::size_t size) {
+                // Constructed inside the scope, so that e.g. guard nodes count.
+                AllocationScope allocations;
+                Collection<typename Payload::value_type> collection;
+
+                for (std::size_t i = 0; i < size; i++)
+                    collection.append(Payload::make(i));
+                return allocations.snapshot();
+            }});
+        }
+
+        void run(std::ostream &out, BenchmarkResults *results = nullptr) const
+        {
+            out << "\nmemory footprint, " << Payload::name() << " (sizeof " << sizeof(typename Payload::value_type)
+                << " B; bytes per element unless noted):\n";
+            out << std::right << std::setw(16) << "container" << std::setw(10) << "size"
+                << std::setw(12) << "allocs" << std::setw(12) << "total req" << std::setw(12) << "usable"
+                << std::setw(12) << "+headers" << std::setw(12) << "rounding" << std::setw(14) << "peak live" << '\n';
+
+            for (std::size_t size : sizes)
+            {
+                for (const Contender &contender : contenders)
+                {
+                    AllocationStatistics statistics = contender.measure(size);
+                    printRow(out, contender.name, size, statistics);
+
+                    if (results)
+                        record(*results, contender.name, size, statistics);
+                }
+            }
+
+            out << "peak RSS so far: " << AllocationTracker::peakResidentBytes() / 1024 << " KiB\n";
+        }
+
+    private:
+        static void printRow(std::ostream &out, const std::string &name, std::size_t size,
+                             const AllocationStatistics &statistics)
+        {
+            const double perElement = 1.0 / size;
+            // Extra usable bytes malloc hands out beyond what was requested.
+            const double rounding = statistics.requestedBytes > 0
+                                    ? static_cast<double>(statistics.usableBytes) / statistics.requestedBytes - 1 : 0;
+
+            out << std::right << std::setw(16) << name << std::setw(10) << size
+                << std::setw(12) << format(statistics.liveBlocks() * perElement)
+                << std::setw(12) << format(statistics.requestedBytes * perElement)
+                << std::setw(12) << format(statistics.liveBytes * perElement)
+                << std::setw(12) << format(statistics.liveHeapBytes() * perElement)
+                << std::setw(11) << format(rounding * 100) << '%'
+                << std::setw(12) << statistics.peakLiveBytes / 1024 << " K" << '\n';
+        }
+
+        static void record(BenchmarkResults &results, const std::string &name, std::size_t size,
+                           const AllocationStatistics &statistics)
+        {
+            BenchmarkRecord record;
+            record.operation = "memory footprint";
+            record.container = name;
+            record.type = Payload::name();
+            record.size = size;
+            record.allocations = statistics;
+            results.add(record);
+        }
+
+        static std::string format(double value)
+        {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+            return buffer;
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_MEMORYFOOTPRINT_H
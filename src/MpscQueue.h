@@ -0,0 +1,245 @@
+#ifndef AISDI_LINEAR_MPSCQUEUE_H
+#define AISDI_LINEAR_MPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "NodePool.h"
+
+namespace aisdi
+{
+
+    // Unbounded multi-producer single-consumer FIFO after Dmitry Vyukov's
+    // intrusive MPSC queue. A push is one exchange on head and one store,
+    // so producers never wait for each other or for the consumer, and a
+    // pop is plain loads and stores. As in ForwardList, nodes carry a
+    // single link and the queue starts from a guard node of its own.
+    //
+    // push() allocates every node with new. A Producer from addProducer()
+    // takes its nodes from a NodePool instead, and the consumer hands
+    // popped nodes back to the producer that made them, so a steady
+    // stream of pushes stops allocating.
+    template<typename Type>
+    class MpscQueue
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = Type;
+
+        class Producer;
+
+    private:
+        static const size_type CACHE_LINE = 64;
+
+        struct Node
+        {
+            std::atomic<Node*> next;
+            Producer *owner;
+            typename std::aligned_storage<sizeof(Type), alignof(Type)>::type storage;
+
+            explicit Node(Producer *owner = nullptr)
+                : next(nullptr),
+                  owner(owner)
+            {}
+
+            Type &value()
+            {
+                return *reinterpret_cast<Type*>(&storage);
+            }
+        };
+
+        // Producers link new nodes after head. tail is the node whose value
+        // was taken last, or the guard; the next value is in the node after.
+        // Padding keeps the two off one cache line, without the
+        // over-aligned new that alignas would need before C++17.
+        std::atomic<Node*> head;
+        char headPadding[CACHE_LINE];
+        Node *tail;
+        char tailPadding[CACHE_LINE];
+        Node guard;
+
+        std::mutex producersMutex;
+        std::vector<std::unique_ptr<Producer>> producers;
+
+    public:
+        MpscQueue()
+            : head(&guard),
+              tail(&guard)
+        {}
+
+        MpscQueue(const MpscQueue &) = delete;
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+        // Must not race with pushes or pops.
+        ~MpscQueue()
+        {
+            Node *node = tail;
+            for (Node *next = node->next.load(std::memory_order_acquire); next != nullptr;
+                 next = node->next.load(std::memory_order_acquire))
+            {
+                next->value().~Type();
+                release(node);
+                node = next;
+            }
+
+            release(node);
+        }
+
+        // Safe from any thread. The producer lives as long as the queue.
+        Producer &addProducer()
+        {
+            std::lock_guard<std::mutex> lock(producersMutex);
+            producers.emplace_back(new Producer(*this));
+            return *producers.back();
+        }
+
+        // Safe from any thread.
+        void push(const Type &item)
+        {
+            enqueue(createNode(nullptr, item));
+        }
+
+        void push(Type &&item)
+        {
+            enqueue(createNode(nullptr, std::move(item)));
+        }
+
+        // Consumer only. Returns false when the queue is empty, and also for
+        // a moment while a producer is between its two steps of a push.
+        bool tryPop(Type &item)
+        {
+            Node *next = tail->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return false;
+
+            item = std::move(next->value());
+            next->value().~Type();
+
+            Node *old = tail;
+            tail = next;
+            release(old);
+
+            return true;
+        }
+
+        // Consumer only.
+        bool isEmpty() const
+        {
+            return tail->next.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        template<typename Value>
+        static Node *createNode(Producer *owner, Value &&item)
+        {
+            std::unique_ptr<Node> node(new Node(owner));
+            new (&node->storage) Type(std::forward<Value>(item));
+            return node.release();
+        }
+
+        void enqueue(Node *node)
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            Node *previous = head.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        // Takes a node whose value is gone: back to its producer, or freed.
+        void release(Node *node)
+        {
+            if (node == &guard)
+                return;
+
+            if (node->owner != nullptr)
+                node->owner->giveBack(node);
+            else
+                delete node;
+        }
+    };
+
+    // A thread's handle for pushing with recycled nodes. Each Producer is
+    // meant for one thread at a time.
+    template<typename Type>
+    class MpscQueue<Type>::Producer
+    {
+        MpscQueue &queue;
+        NodePool<Node> pool;
+        // Nodes this producer may reuse right away, linked through next.
+        Node *recycled = nullptr;
+        // Nodes the consumer gave back since the producer last looked. The
+        // consumer only pushes and the producer takes all at once, so the
+        // stack is free of ABA.
+        char padding[CACHE_LINE];
+        std::atomic<Node*> returned;
+
+        explicit Producer(MpscQueue &queue)
+            : queue(queue),
+              returned(nullptr)
+        {}
+
+    public:
+        Producer(const Producer &) = delete;
+        Producer &operator=(const Producer &) = delete;
+
+        void push(const Type &item)
+        {
+            queue.enqueue(takeNode(item));
+        }
+
+        void push(Type &&item)
+        {
+            queue.enqueue(takeNode(std::move(item)));
+        }
+
+        friend class MpscQueue;
+
+    private:
+        template<typename Value>
+        Node *takeNode(Value &&item)
+        {
+            if (recycled == nullptr)
+                recycled = returned.exchange(nullptr, std::memory_order_acquire);
+
+            Node *node;
+            if (recycled != nullptr)
+            {
+                node = recycled;
+                recycled = node->next.load(std::memory_order_relaxed);
+            }
+            else
+                node = pool.create(this);
+
+            try
+            {
+                new (&node->storage) Type(std::forward<Value>(item));
+            }
+            catch (...)
+            {
+                node->next.store(recycled, std::memory_order_relaxed);
+                recycled = node;
+                throw;
+            }
+
+            return node;
+        }
+
+        // Called by the consumer.
+        void giveBack(Node *node)
+        {
+            Node *top = returned.load(std::memory_order_relaxed);
+            do
+                node->next.store(top, std::memory_order_relaxed);
+            while (!returned.compare_exchange_weak(top, node, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_MPSCQUEUE_H
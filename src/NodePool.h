@@ -0,0 +1,157 @@
+#ifndef AISDI_LINEAR_NODEPOOL_H
+#define AISDI_LINEAR_NODEPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+    // Allocates every node separately with new/delete.
+    template<typename NodeType>
+    class HeapNodeAllocator
+    {
+    public:
+        template<typename... Args>
+        NodeType *create(Args&&... args)
+        {
+            return new NodeType(std::forward<Args>(args)...);
+        }
+
+        void destroy(NodeType *node)
+        {
+            delete node;
+        }
+
+        void swap(HeapNodeAllocator &)
+        {}
+    };
+
+    // Carves nodes out of geometrically growing chunks and recycles released
+    // nodes through an intrusive free list. Memory goes back to the system
+    // only when the pool itself is destroyed.
+    template<typename NodeType>
+    class NodePool
+    {
+    public:
+        using size_type = std::size_t;
+
+    private:
+        union Slot
+        {
+            Slot *nextFree;
+            typename std::aligned_storage<sizeof(NodeType), alignof(NodeType)>::type storage;
+        };
+
+        struct Chunk
+        {
+            Chunk *next;
+            size_type capacity;
+            Slot *slots;
+        };
+
+        static const size_type INITIAL_CHUNK_CAPACITY = 32;
+        static const size_type MAX_CHUNK_CAPACITY = 4096;
+
+        Slot *freeSlots;
+        Chunk *chunks;
+        size_type usedInLastChunk;
+
+    public:
+        NodePool()
+            : freeSlots(nullptr),
+              chunks(nullptr),
+              usedInLastChunk(0)
+        {}
+
+        NodePool(const NodePool &) = delete;
+        NodePool &operator=(const NodePool &) = delete;
+
+        ~NodePool()
+        {
+            releaseChunks();
+        }
+
+        template<typename... Args>
+        NodeType *create(Args&&... args)
+        {
+            Slot *slot = takeSlot();
+
+            try
+            {
+                return new (&slot->storage) NodeType(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                giveBackSlot(slot);
+                throw;
+            }
+        }
+
+        void destroy(NodeType *node)
+        {
+            node->~NodeType();
+            giveBackSlot(reinterpret_cast<Slot*>(node));
+        }
+
+        void swap(NodePool &other)
+        {
+            std::swap(freeSlots, other.freeSlots);
+            std::swap(chunks, other.chunks);
+            std::swap(usedInLastChunk, other.usedInLastChunk);
+        }
+
+    private:
+        Slot *takeSlot()
+        {
+            if (freeSlots != nullptr)
+            {
+                Slot *slot = freeSlots;
+                freeSlots = slot->nextFree;
+                return slot;
+            }
+
+            if (chunks == nullptr || usedInLastChunk == chunks->capacity)
+                allocateChunk();
+
+            return &chunks->slots[usedInLastChunk++];
+        }
+
+        void giveBackSlot(Slot *slot)
+        {
+            slot->nextFree = freeSlots;
+            freeSlots = slot;
+        }
+
+        void allocateChunk()
+        {
+            size_type capacity = chunks == nullptr ? INITIAL_CHUNK_CAPACITY : chunks->capacity * 2;
+            if (capacity > MAX_CHUNK_CAPACITY)
+                capacity = MAX_CHUNK_CAPACITY;
+
+            Chunk *chunk = new Chunk;
+            chunk->next = chunks;
+            chunk->capacity = capacity;
+            chunk->slots = new Slot[capacity];
+
+            chunks = chunk;
+            usedInLastChunk = 0;
+        }
+
+        void releaseChunks()
+        {
+            while (chunks != nullptr)
+            {
+                Chunk *old = chunks;
+                chunks = chunks->next;
+                delete [] old->slots;
+                delete old;
+            }
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_NODEPOOL_H
@@ -0,0 +1,119 @@
+#ifndef AISDI_LINEAR_OPERATIONCOUNTINGOBJECT_H
+#define AISDI_LINEAR_OPERATIONCOUNTINGOBJECT_H
+
+#include <cstddef>
+#include <ostream>
+#include <utility>
+
+namespace aisdi
+{
+
+    // Element type that counts its own special member calls. Used by the
+    // tests to check object lifetimes and by the benchmarks as a payload
+    // with non-trivial special members.
+    class OperationCountingObject
+    {
+    public:
+        OperationCountingObject(int value_ = 0)
+                : value(value_)
+        {
+            ++counters().constructedObjects;
+        }
+
+        OperationCountingObject(const OperationCountingObject &other)
+                : value(std::move(other.value))
+        {
+            ++counters().constructedObjects;
+            ++counters().copiedObjects;
+        }
+
+        OperationCountingObject(OperationCountingObject &&other)
+                : value(other.value)
+        {
+            ++counters().constructedObjects;
+            ++counters().movedObjects;
+        }
+
+        ~OperationCountingObject()
+        {
+            ++counters().destroyedObjects;
+        }
+
+        OperationCountingObject &operator=(const OperationCountingObject &other)
+        {
+            ++counters().assignedObjects;
+            value = other.value;
+            return *this;
+        }
+
+        OperationCountingObject &operator=(OperationCountingObject &&other)
+        {
+            ++counters().assignedObjects;
+            ++counters().movedObjects;
+            value = std::move(other.value);
+            return *this;
+        }
+
+        operator int() const
+        {
+            return value;
+        }
+
+        static void resetCounters()
+        {
+            counters() = Counters();
+        }
+
+        static std::size_t constructedObjectsCount()
+        {
+            return counters().constructedObjects;
+        }
+
+        static std::size_t destroyedObjectsCount()
+        {
+            return counters().destroyedObjects;
+        }
+
+        static std::size_t copiedObjectsCount()
+        {
+            return counters().copiedObjects;
+        }
+
+        static std::size_t movedObjectsCount()
+        {
+            return counters().movedObjects;
+        }
+
+        static std::size_t assignedObjectsCount()
+        {
+            return counters().assignedObjects;
+        }
+
+    private:
+        struct Counters
+        {
+            std::size_t constructedObjects = 0;
+            std::size_t destroyedObjects = 0;
+            std::size_t copiedObjects = 0;
+            std::size_t movedObjects = 0;
+            std::size_t assignedObjects = 0;
+        };
+
+        int value;
+
+        // Function-local so that the header needs no out-of-line definitions.
+        static Counters &counters()
+        {
+            static Counters instance;
+            return instance;
+        }
+    };
+
+    inline std::ostream &operator<<(std::ostream &out, const OperationCountingObject &obj)
+    {
+        return out << '<' << static_cast<int>(obj) << '>';
+    }
+
+}
+
+#endif // AISDI_LINEAR_OPERATIONCOUNTINGOBJECT_H
@@ -0,0 +1,458 @@
+#ifndef AISDI_LINEAR_OPERATIONMATRIX_H
+#define AISDI_LINEAR_OPERATIONMATRIX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "Benchmark.h"
+#include "BenchmarkPayloads.h"
+#include "BenchmarkResults.h"
+
+namespace aisdi
+{
+
+    enum class Operation
+    {
+        APPEND,
+        PREPEND,
+        MIDDLE_INSERT,
+        ERASE,
+        RANGE_ERASE,
+        POP_FIRST,
+        POP_LAST,
+        ITERATE,
+        SEEK,
+        COPY_CONSTRUCT,
+        COPY_ASSIGN,
+        MOVE
+    };
+
+    inline const std::vector<Operation> &allOperations()
+    {
+        static const std::vector<Operation> operations = {
+            Operation::APPEND, Operation::PREPEND, Operation::MIDDLE_INSERT,
+            Operation::ERASE, Operation::RANGE_ERASE, Operation::POP_FIRST,
+            Operation::POP_LAST, Operation::ITERATE, Operation::SEEK,
+            Operation::COPY_CONSTRUCT, Operation::COPY_ASSIGN, Operation::MOVE
+        };
+        return operations;
+    }
+
+    inline const char *operationName(Operation operation)
+    {
+        switch (operation)
+        {
+            case Operation::APPEND: return "append";
+            case Operation::PREPEND: return "prepend";
+            case Operation::MIDDLE_INSERT: return "insert at begin() + size/2";
+            case Operation::ERASE: return "erase at begin() + size/2";
+            case Operation::RANGE_ERASE: return "erase middle half as a range";
+            case Operation::POP_FIRST: return "popFirst";
+            case Operation::POP_LAST: return "popLast";
+            case Operation::ITERATE: return "full iteration, per element";
+            case Operation::SEEK: return "seek to begin() + k";
+            case Operation::COPY_CONSTRUCT: return "copy construction, per element";
+            case Operation::COPY_ASSIGN: return "copy assignment, per element";
+            case Operation::MOVE: return "move construction and assignment";
+        }
+        return "unknown";
+    }
+
+    struct InstrumentedRun
+    {
+        ObjectCounts objects;
+        AllocationStatistics allocations;
+    };
+
+    // Replaces timing with a single instrumented run that counts what the
+    // scenario does to Counted<T> elements and to the heap. Used as the
+    // executor of an OperationScenario in place of a Benchmark.
+    template<typename T>
+    class ObjectCounter
+    {
+    public:
+        using Result = InstrumentedRun;
+
+        template<typename Setup, typename Scenario>
+        InstrumentedRun run(Setup setup, Scenario scenario, std::size_t) const
+        {
+            setup();
+            Counted<T>::counts() = ObjectCounts();
+
+            InstrumentedRun result;
+            {
+                AllocationScope allocations;
+                scenario();
+                result.allocations = allocations.snapshot();
+            }
+            result.objects = Counted<T>::counts();
+            return result;
+        }
+    };
+
+    // Performs a single operation on a collection that already holds size
+    // elements, made by Payload. The executor (a Benchmark or an
+    // ObjectCounter) is given an untimed setup restoring a fresh copy and the
+    // scenario itself. Operations whose cost may grow with size are batched
+    // less so that the largest sizes still finish in reasonable time.
+    template<typename Collection, typename Payload>
+    class OperationScenario
+    {
+    public:
+        using value_type = typename Collection::value_type;
+
+    private:
+        static constexpr std::size_t MAX_BATCH = 1000;
+        // Upper bound on batch * size for operations that might be linear.
+        static constexpr std::size_t LINEAR_WORK = 1000000;
+
+        std::size_t size;
+        Collection prototype;
+        Collection target;
+
+    public:
+        explicit OperationScenario(std::size_t size)
+            : size(size)
+        {
+            for (std::size_t i = 0; i < size; i++)
+                prototype.append(Payload::make(i));
+        }
+
+        // Returns the operation count the executor's result is relative to.
+        static std::size_t operationsPerRun(Operation operation, std::size_t size)
+        {
+            const std::size_t linearBatch = std::max<std::size_t>(1, std::min(MAX_BATCH, LINEAR_WORK / size));
+
+            switch (operation)
+            {
+                case Operation::APPEND:
+                case Operation::MOVE:
+                    return MAX_BATCH;
+                case Operation::PREPEND:
+                case Operation::MIDDLE_INSERT:
+                case Operation::SEEK:
+                    return linearBatch;
+                case Operation::ERASE:
+                case Operation::POP_FIRST:
+                    return std::min(linearBatch, size);
+                case Operation::POP_LAST:
+                    return std::min(MAX_BATCH, size);
+                case Operation::RANGE_ERASE:
+                    return std::max<std::size_t>(1, size / 2);
+                case Operation::ITERATE:
+                case Operation::COPY_CONSTRUCT:
+                case Operation::COPY_ASSIGN:
+                    return size;
+            }
+            return 1;
+        }
+
+        template<typename Executor>
+        typename Executor::Result perform(Operation operation, const Executor &executor)
+        {
+            const std::size_t operations = operationsPerRun(operation, size);
+            auto restore = [this]() { target = prototype; };
+
+            switch (operation)
+            {
+                case Operation::APPEND:
+                    return executor.run(restore, [this, operations]() {
+                        for (std::size_t i = 0; i < operations; i++)
+                            target.append(Payload::make(i));
+                    }, operations);
+
+                case Operation::PREPEND:
+                    return executor.run(restore, [this, operations]() {
+                        for (std::size_t i = 0; i < operations; i++)
+                            target.prepend(Payload::make(i));
+                    }, operations);
+
+                case Operation::MIDDLE_INSERT:
+                    return executor.run(restore, [this, operations]() {
+                        for (std::size_t i = 0; i < operations; i++)
+                            target.insert(target.begin() + target.getSize() / 2, Payload::make(i));
+                    }, operations);
+
+                case Operation::ERASE:
+                    return executor.run(restore, [this, operations]() {
+                        for (std::size_t i = 0; i < operations; i++)
+                            target.erase(target.begin() + target.getSize() / 2);
+                    }, operations);
+
+                case Operation::RANGE_ERASE:
+                    return executor.run(restore, [this, operations]() {
+                        auto first = target.begin() + size / 4;
+                        target.erase(first, first + operations);
+                    }, operations);
+
+                case Operation::POP_FIRST:
+                    return executor.run(restore, [this, operations]() {
+                        for (std::size_t i = 0; i < operations; i++)
+                            doNotOptimize(Payload::checksum(target.popFirst()));
+                    }, operations);
+
+                case Operation::POP_LAST:
+                    return executor.run(restore, [this, operations]() {
+                        for (std::size_t i = 0; i < operations; i++)
+                            doNotOptimize(Payload::checksum(target.popLast()));
+                    }, operations);
+
+                case Operation::ITERATE:
+                    return executor.run([]() {}, [this]() {
+                        std::size_t sum = 0;
+                        for (const value_type &value : prototype)
+                            sum += Payload::checksum(value);
+                        doNotOptimize(sum);
+                    }, operations);
+
+                case Operation::SEEK:
+                {
+                    std::vector<std::size_t> positions(operations);
+                    std::mt19937_64 random(size);
+                    for (std::size_t &position : positions)
+                        position = random() % size;
+
+                    return executor.run([]() {}, [this, positions]() {
+                        for (std::size_t position : positions)
+                            doNotOptimize(Payload::checksum(*(prototype.cbegin() + position)));
+                    }, operations);
+                }
+
+                case Operation::COPY_CONSTRUCT:
+                {
+                    // The copy is destroyed by the next setup, outside the timed region.
+                    std::unique_ptr<Collection> copy;
+                    return executor.run([&copy]() { copy.reset(); }, [this, &copy]() {
+                        copy.reset(new Collection(prototype));
+                    }, operations);
+                }
+
+                case Operation::COPY_ASSIGN:
+                    return executor.run(restore, [this]() {
+                        target = prototype;
+                    }, operations);
+
+                case Operation::MOVE:
+                    return executor.run(restore, [this, operations]() {
+                        for (std::size_t i = 0; i < operations; i++)
+                        {
+                            Collection moved(std::move(target));
+                            target = std::move(moved);
+                        }
+                    }, operations);
+            }
+
+            return typename Executor::Result();
+        }
+    };
+
+    template<typename Collection, typename Payload>
+    constexpr std::size_t OperationScenario<Collection, Payload>::MAX_BATCH;
+
+    template<typename Collection, typename Payload>
+    constexpr std::size_t OperationScenario<Collection, Payload>::LINEAR_WORK;
+
+    struct OperationResult
+    {
+        BenchmarkStatistics statistics;
+        ObjectCounts counts;
+        AllocationStatistics allocations;
+    };
+
+    // Runs every operation for every contender across a range of sizes and
+    // prints one table per operation, with a row per size and contender.
+    // A contender may name a baseline contender (its standard library
+    // counterpart); rows more than SLOWDOWN_LIMIT slower than the baseline
+    // are flagged. Element counts come from a separate untimed run over Counted elements,
+    // so they are reported for every payload without slowing down the timed
+    // runs.
+    template<typename Payload>
+    class OperationMatrix
+    {
+        using Measurement = std::function<OperationResult(const Benchmark &, Operation, std::size_t)>;
+
+        struct Contender
+        {
+            std::string name;
+            std::string baseline;
+            Measurement measure;
+        };
+
+        Benchmark benchmark;
+        std::vector<std::size_t> sizes;
+        std::vector<Contender> contenders;
+
+    public:
+        static constexpr double SLOWDOWN_LIMIT = 0.2;
+
+        explicit OperationMatrix(const std::vector<std::size_t> &sizes,
+                                 const BenchmarkSettings &settings = BenchmarkSettings())
+            : benchmark(settings), sizes(sizes)
+        {}
+
+        template<template<typename> class Collection>
+        void addContender(const std::string &name, const std::string &baseline = "")
+        {
+            using value_type = typename Payload::value_type;
+
+            contenders.push_back({name, baseline, [](const Benchmark &benchmark, Operation operation, std::size_t size) {
+                OperationResult result;
+                result.statistics = OperationScenario<Collection<value_type>, Payload>(size)
+                        .perform(operation, benchmark);
+                InstrumentedRun instrumented =
+                        OperationScenario<Collection<Counted<value_type>>, CountedPayload<Payload>>(size)
+                                .perform(operation, ObjectCounter<value_type>());
+                result.counts = instrumented.objects;
+                result.allocations = instrumented.allocations;
+                return result;
+            }});
+        }
+
+        // Prints the tables to out and, if given, also adds every
+        // measurement to results.
+        void run(std::ostream &out, BenchmarkResults *results = nullptr) const
+        {
+            for (Operation operation : allOperations())
+            {
+                printHeader(out, operation);
+
+                for (std::size_t size : sizes)
+                {
+                    std::vector<OperationResult> row;
+                    for (const Contender &contender : contenders)
+                        row.push_back(contender.measure(benchmark, operation, size));
+                    printRow(out, size, row);
+                    printHardware(out, row);
+
+                    if (results)
+                        record(*results, operation, size, row);
+                }
+            }
+        }
+
+    private:
+        void record(BenchmarkResults &results, Operation operation, std::size_t size,
+                    const std::vector<OperationResult> &row) const
+        {
+            for (std::size_t i = 0; i < row.size(); i++)
+            {
+                BenchmarkRecord record;
+                record.operation = operationName(operation);
+                record.container = contenders[i].name;
+                record.type = Payload::name();
+                record.size = size;
+                record.statistics = row[i].statistics;
+                record.counts = row[i].counts;
+                record.allocations = row[i].allocations;
+                results.add(record);
+            }
+        }
+
+        void printHeader(std::ostream &out, Operation operation) const
+        {
+            out << '\n' << operationName(operation) << ", " << Payload::name()
+                << " (median ns/op [p10, p90]; constructions, copies, moves, allocations per op):\n";
+            out << std::right << std::setw(10) << "size" << std::setw(16) << "container"
+                << std::setw(30) << "ns/op" << std::setw(26) << "ctor/copy/move/alloc" << "  notes\n";
+        }
+
+        void printRow(std::ostream &out, std::size_t size, const std::vector<OperationResult> &row) const
+        {
+            std::size_t fastest = 0;
+            for (std::size_t i = 0; i < row.size(); i++)
+                if (row[i].statistics.nanosecondsPerOperation() < row[fastest].statistics.nanosecondsPerOperation())
+                    fastest = i;
+
+            for (std::size_t i = 0; i < row.size(); i++)
+            {
+                std::string notes = i == fastest ? "fastest" : "";
+                std::string slowdown = formatSlowdown(i, row);
+                if (!slowdown.empty())
+                    notes += (notes.empty() ? "" : ", ") + slowdown;
+
+                out << std::right << std::setw(10) << (i == 0 ? std::to_string(size) : "")
+                    << std::setw(16) << contenders[i].name
+                    << std::setw(30) << formatTiming(row[i].statistics)
+                    << std::setw(26) << formatCounts(row[i], row[i].statistics.operationsPerRun)
+                    << "  " << notes << '\n';
+            }
+        }
+
+        // "!! +35% vs std::list" when the contender is more than
+        // SLOWDOWN_LIMIT slower than its baseline, empty otherwise.
+        std::string formatSlowdown(std::size_t contender, const std::vector<OperationResult> &row) const
+        {
+            const std::string &baseline = contenders[contender].baseline;
+
+            for (std::size_t i = 0; i < row.size() && !baseline.empty(); i++)
+            {
+                if (contenders[i].name != baseline)
+                    continue;
+
+                const double reference = row[i].statistics.nanosecondsPerOperation();
+                const double measured = row[contender].statistics.nanosecondsPerOperation();
+                if (reference <= 0 || measured <= reference * (1 + SLOWDOWN_LIMIT))
+                    return "";
+
+                char buffer[64];
+                std::snprintf(buffer, sizeof(buffer), "!! %+.0f%% vs ", (measured / reference - 1) * 100);
+                return buffer + baseline;
+            }
+
+            return "";
+        }
+
+        // One indented line per contender, when hardware counters were read.
+        void printHardware(std::ostream &out, const std::vector<OperationResult> &row) const
+        {
+            for (std::size_t i = 0; i < row.size(); i++)
+                if (row[i].statistics.hardware.any())
+                    out << std::setw(14) << "" << contenders[i].name << ": "
+                        << Benchmark::formatHardware(row[i].statistics) << '\n';
+        }
+
+        static std::string formatTiming(const BenchmarkStatistics &statistics)
+        {
+            const double scale = statistics.operationsPerRun > 0 ? 1e9 / statistics.operationsPerRun : 0;
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.1f [%.1f, %.1f]",
+                          statistics.median * scale, statistics.p10 * scale, statistics.p90 * scale);
+            return buffer;
+        }
+
+        static std::string formatCounts(const OperationResult &result, std::size_t operations)
+        {
+            const ObjectCounts &counts = result.counts;
+            const double scale = operations > 0 ? 1.0 / operations : 0;
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.1f/%.1f/%.1f/%.2f",
+                          counts.constructions * scale, counts.copies * scale, counts.moves * scale,
+                          result.allocations.allocations * scale);
+            return buffer;
+        }
+    };
+
+    template<typename Payload>
+    constexpr double OperationMatrix<Payload>::SLOWDOWN_LIMIT;
+
+    // Sizes 10, 100, ... up to and including maxSize.
+    inline std::vector<std::size_t> decadeSizes(std::size_t maxSize)
+    {
+        std::vector<std::size_t> sizes;
+        for (std::size_t size = 10; size <= maxSize; size *= 10)
+            sizes.push_back(size);
+        return sizes;
+    }
+}
+
+#endif // AISDI_LINEAR_OPERATIONMATRIX_H
@@ -0,0 +1,445 @@
+#ifndef AISDI_LINEAR_OPERATIONTRACE_H
+#define AISDI_LINEAR_OPERATIONTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aisdi
+{
+
+    // Binary trace of collection operations: a 16-byte header followed by
+    // fixed-size 16-byte records in native byte order (the header lets a
+    // reader detect a mismatch). Fixed-size records can be memory-mapped
+    // and indexed directly.
+
+    enum class TraceOperation : std::uint8_t
+    {
+        APPEND,
+        PREPEND,
+        INSERT,         // at position
+        ERASE,          // at position
+        ERASE_RANGE,    // value elements from position
+        POP_FIRST,
+        POP_LAST,
+        READ,           // element at position, via begin() + position
+        ITERATE         // over the whole collection
+    };
+
+    struct TraceHeader
+    {
+        static constexpr std::uint32_t VERSION = 1;
+        static constexpr std::uint32_t NATIVE_BYTE_ORDER = 0x01020304;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+
+        static TraceHeader current()
+        {
+            TraceHeader header;
+            std::memcpy(header.magic, "AISDITRC", sizeof(header.magic));
+            header.version = VERSION;
+            header.byteOrder = NATIVE_BYTE_ORDER;
+            return header;
+        }
+
+        void validate() const
+        {
+            if (std::memcmp(magic, "AISDITRC", sizeof(magic)) != 0)
+                throw std::runtime_error("not an operation trace");
+            if (byteOrder != NATIVE_BYTE_ORDER)
+                throw std::runtime_error("operation trace has foreign byte order");
+            if (version != VERSION)
+                throw std::runtime_error("unsupported operation trace version " + std::to_string(version));
+        }
+    };
+
+    struct TraceRecord
+    {
+        TraceOperation operation;
+        std::uint8_t reserved[3];
+        std::uint32_t position;
+        std::int64_t value;
+
+        static TraceRecord make(TraceOperation operation, std::size_t position = 0, std::int64_t value = 0)
+        {
+            TraceRecord record;
+            record.operation = operation;
+            std::memset(record.reserved, 0, sizeof(record.reserved));
+            record.position = static_cast<std::uint32_t>(position);
+            record.value = value;
+            return record;
+        }
+    };
+
+    static_assert(sizeof(TraceHeader) == 16, "trace header must stay 16 bytes");
+    static_assert(sizeof(TraceRecord) == 16, "trace records must stay 16 bytes");
+
+    class TraceWriter
+    {
+        std::ostream &out;
+        std::size_t recordCount = 0;
+
+    public:
+        explicit TraceWriter(std::ostream &out)
+            : out(out)
+        {
+            TraceHeader header = TraceHeader::current();
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        }
+
+        void write(const TraceRecord &record)
+        {
+            out.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            recordCount++;
+        }
+
+        std::size_t getRecordCount() const
+        {
+            return recordCount;
+        }
+    };
+
+    // Reads a trace from a stream in chunks, never holding all of it.
+    class TraceStreamReader
+    {
+        static const std::size_t CHUNK_RECORDS = 4096;
+
+        std::istream &in;
+
+    public:
+        explicit TraceStreamReader(std::istream &in)
+            : in(in)
+        {
+            TraceHeader header;
+            if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+                throw std::runtime_error("operation trace is truncated");
+            header.validate();
+        }
+
+        template<typename Visitor>
+        std::size_t forEach(Visitor visit)
+        {
+            std::vector<TraceRecord> chunk(CHUNK_RECORDS);
+            std::size_t count = 0;
+
+            while (in)
+            {
+                in.read(reinterpret_cast<char *>(chunk.data()), CHUNK_RECORDS * sizeof(TraceRecord));
+                std::size_t read = static_cast<std::size_t>(in.gcount()) / sizeof(TraceRecord);
+
+                for (std::size_t i = 0; i < read; i++)
+                    visit(chunk[i]);
+                count += read;
+            }
+
+            return count;
+        }
+    };
+
+    // Maps a whole trace file into memory; records are visited in place.
+    class MappedTrace
+    {
+        const void *mapping = nullptr;
+        std::size_t mappingSize = 0;
+        const TraceRecord *records = nullptr;
+        std::size_t recordCount = 0;
+
+    public:
+        explicit MappedTrace(const std::string &path)
+        {
+#ifdef __unix__
+            int descriptor = open(path.c_str(), O_RDONLY);
+            if (descriptor < 0)
+                throw std::runtime_error("cannot open " + path);
+
+            struct stat status;
+            if (fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(TraceHeader))
+            {
+                close(descriptor);
+                throw std::runtime_error("operation trace is truncated: " + path);
+            }
+
+            mappingSize = static_cast<std::size_t>(status.st_size);
+            void *address = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            close(descriptor);
+
+            if (address == MAP_FAILED)
+                throw std::runtime_error("cannot map " + path);
+            mapping = address;
+            madvise(address, mappingSize, MADV_SEQUENTIAL);
+
+            const TraceHeader *header = static_cast<const TraceHeader *>(mapping);
+            try
+            {
+                header->validate();
+            }
+            catch (...)
+            {
+                munmap(address, mappingSize);
+                throw;
+            }
+
+            records = reinterpret_cast<const TraceRecord *>(header + 1);
+            recordCount = (mappingSize - sizeof(TraceHeader)) / sizeof(TraceRecord);
+#else
+            throw std::runtime_error("memory-mapped traces need a POSIX system: " + path);
+#endif
+        }
+
+        ~MappedTrace()
+        {
+#ifdef __unix__
+            if (mapping)
+                munmap(const_cast<void *>(mapping), mappingSize);
+#endif
+        }
+
+        MappedTrace(const MappedTrace &) = delete;
+        MappedTrace &operator=(const MappedTrace &) = delete;
+
+        std::size_t size() const
+        {
+            return recordCount;
+        }
+
+        template<typename Visitor>
+        std::size_t forEach(Visitor visit) const
+        {
+            for (std::size_t i = 0; i < recordCount; i++)
+                visit(records[i]);
+            return recordCount;
+        }
+    };
+
+    namespace detail
+    {
+
+        // Index of an iterator: in O(1) when the iterator knows it, else by
+        // walking from begin().
+        template<typename Collection, typename Iterator>
+        auto traceIndexOf(const Collection &, const Iterator &position, int)
+            -> decltype(static_cast<std::size_t>(position.calculateIndex()))
+        {
+            return position.calculateIndex();
+        }
+
+        template<typename Collection, typename Iterator>
+        auto traceIndexOf(const Collection &, const Iterator &position, long)
+            -> decltype(static_cast<std::size_t>(position.getIndex()))
+        {
+            return position.getIndex();
+        }
+
+        template<typename Collection, typename Iterator>
+        std::size_t traceIndexOf(const Collection &collection, const Iterator &position, ...)
+        {
+            std::size_t index = 0;
+            for (auto it = collection.cbegin(); it != position; ++it)
+                index++;
+            return index;
+        }
+
+    }
+
+    // A collection that records every modifying call it forwards, so that
+    // a trace can be captured from a live program by changing one type.
+    // Calls are recorded once they return, so one that throws leaves no
+    // record; positions are taken before, while the iterators are valid.
+    template<typename Collection>
+    class RecordingCollection : public Collection
+    {
+        TraceWriter &writer;
+
+    public:
+        using value_type = typename Collection::value_type;
+        using const_iterator = typename Collection::const_iterator;
+
+        explicit RecordingCollection(TraceWriter &writer)
+            : writer(writer)
+        {}
+
+        void append(const value_type &item)
+        {
+            Collection::append(item);
+            writer.write(TraceRecord::make(TraceOperation::APPEND, 0, static_cast<std::int64_t>(item)));
+        }
+
+        void prepend(const value_type &item)
+        {
+            Collection::prepend(item);
+            writer.write(TraceRecord::make(TraceOperation::PREPEND, 0, static_cast<std::int64_t>(item)));
+        }
+
+        void insert(const const_iterator &insertPosition, const value_type &item)
+        {
+            TraceRecord record = TraceRecord::make(TraceOperation::INSERT, indexOf(insertPosition),
+                                                   static_cast<std::int64_t>(item));
+            Collection::insert(insertPosition, item);
+            writer.write(record);
+        }
+
+        value_type popFirst()
+        {
+            value_type value = Collection::popFirst();
+            writer.write(TraceRecord::make(TraceOperation::POP_FIRST));
+            return value;
+        }
+
+        value_type popLast()
+        {
+            value_type value = Collection::popLast();
+            writer.write(TraceRecord::make(TraceOperation::POP_LAST));
+            return value;
+        }
+
+        void erase(const const_iterator &position)
+        {
+            TraceRecord record = TraceRecord::make(TraceOperation::ERASE, indexOf(position));
+            Collection::erase(position);
+            writer.write(record);
+        }
+
+        void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+        {
+            std::size_t first = indexOf(firstIncluded);
+            std::size_t last = indexOf(lastExcluded);
+            TraceRecord record = TraceRecord::make(TraceOperation::ERASE_RANGE, first,
+                                                   static_cast<std::int64_t>(last - first));
+            Collection::erase(firstIncluded, lastExcluded);
+            writer.write(record);
+        }
+
+        // Reads are not visible to a wrapper; callers record them
+        // explicitly where they matter.
+        void recordRead(std::size_t position)
+        {
+            writer.write(TraceRecord::make(TraceOperation::READ, position));
+        }
+
+        void recordIteration()
+        {
+            writer.write(TraceRecord::make(TraceOperation::ITERATE));
+        }
+
+    private:
+        std::size_t indexOf(const const_iterator &position) const
+        {
+            return detail::traceIndexOf(static_cast<const Collection &>(*this), position, 0);
+        }
+    };
+
+    // Applies one record to a collection of integers. Records that do not
+    // fit the collection's current size (e.g. from a trace captured against
+    // a different starting state) are clamped or skipped and counted.
+    template<typename Collection>
+    class TraceReplayer
+    {
+        Collection &collection;
+        std::size_t mismatches = 0;
+        std::size_t checksum = 0;
+
+    public:
+        using value_type = typename Collection::value_type;
+
+        explicit TraceReplayer(Collection &collection)
+            : collection(collection)
+        {}
+
+        void operator()(const TraceRecord &record)
+        {
+            const std::size_t size = collection.getSize();
+            std::size_t position = record.position;
+
+            switch (record.operation)
+            {
+                case TraceOperation::APPEND:
+                    collection.append(static_cast<value_type>(record.value));
+                    return;
+                case TraceOperation::PREPEND:
+                    collection.prepend(static_cast<value_type>(record.value));
+                    return;
+                case TraceOperation::INSERT:
+                    collection.insert(collection.begin() + clamp(position, size), static_cast<value_type>(record.value));
+                    return;
+                case TraceOperation::ITERATE:
+                    for (const value_type &value : collection)
+                        checksum += static_cast<std::size_t>(value);
+                    return;
+                default:
+                    break;
+            }
+
+            if (size == 0)
+            {
+                mismatches++;
+                return;
+            }
+
+            switch (record.operation)
+            {
+                case TraceOperation::ERASE:
+                    collection.erase(collection.begin() + clamp(position, size - 1));
+                    return;
+                case TraceOperation::ERASE_RANGE:
+                {
+                    position = clamp(position, size - 1);
+                    std::size_t count = clamp(static_cast<std::size_t>(record.value), size - position);
+                    auto first = collection.begin() + position;
+                    collection.erase(first, first + count);
+                    return;
+                }
+                case TraceOperation::POP_FIRST:
+                    checksum += static_cast<std::size_t>(collection.popFirst());
+                    return;
+                case TraceOperation::POP_LAST:
+                    checksum += static_cast<std::size_t>(collection.popLast());
+                    return;
+                case TraceOperation::READ:
+                    checksum += static_cast<std::size_t>(*(collection.cbegin() + clamp(position, size - 1)));
+                    return;
+                default:
+                    mismatches++;
+                    return;
+            }
+        }
+
+        std::size_t getMismatches() const
+        {
+            return mismatches;
+        }
+
+        // Sum of everything read, so that reads have an observable effect.
+        std::size_t getChecksum() const
+        {
+            return checksum;
+        }
+
+    private:
+        std::size_t clamp(std::size_t value, std::size_t limit)
+        {
+            if (value <= limit)
+                return value;
+            mismatches++;
+            return limit;
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_OPERATIONTRACE_H
@@ -0,0 +1,252 @@
+#ifndef AISDI_LINEAR_PERFCOUNTERS_H
+#define AISDI_LINEAR_PERFCOUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aisdi
+{
+
+    enum PerfEvent
+    {
+        PERF_CYCLES,
+        PERF_INSTRUCTIONS,
+        PERF_L1D_MISSES,
+        PERF_LLC_MISSES,
+        PERF_DTLB_MISSES,
+        PERF_BRANCH_MISSES,
+        PERF_EVENT_COUNT
+    };
+
+    inline const char *perfEventName(PerfEvent event)
+    {
+        static const char *names[PERF_EVENT_COUNT] = {
+            "cycles", "instructions", "L1d misses", "LLC misses", "dTLB misses", "branch misses"
+        };
+        return names[event];
+    }
+
+    // Event totals; an event the kernel refused to count is left unavailable.
+    struct PerfSample
+    {
+        double values[PERF_EVENT_COUNT] = {};
+        bool available[PERF_EVENT_COUNT] = {};
+
+        bool any() const
+        {
+            for (bool eventAvailable : available)
+                if (eventAvailable)
+                    return true;
+            return false;
+        }
+
+        // Instructions per cycle, or 0 when either count is missing.
+        double ipc() const
+        {
+            if (!available[PERF_CYCLES] || !available[PERF_INSTRUCTIONS] || values[PERF_CYCLES] == 0)
+                return 0;
+            return values[PERF_INSTRUCTIONS] / values[PERF_CYCLES];
+        }
+
+        PerfSample &operator+=(const PerfSample &other)
+        {
+            for (std::size_t i = 0; i < PERF_EVENT_COUNT; i++)
+            {
+                values[i] += other.values[i];
+                available[i] = other.available[i];
+            }
+            return *this;
+        }
+
+        PerfSample &operator/=(double divisor)
+        {
+            for (double &value : values)
+                value /= divisor;
+            return *this;
+        }
+    };
+
+    // Counts hardware events of the calling thread between start() and
+    // stop(), using one perf_event_open descriptor per event. Events are
+    // opened independently so that a PMU lacking e.g. a dTLB event still
+    // reports the rest. When perf_event_paranoid (or a container seccomp
+    // profile) forbids access, or on non-Linux systems, nothing is counted
+    // and isAvailable() returns false; the benchmarks run unchanged.
+    class PerfCounters
+    {
+        int descriptors[PERF_EVENT_COUNT];
+        std::string status;
+
+    public:
+        explicit PerfCounters(bool enabled = true)
+        {
+            for (int &descriptor : descriptors)
+                descriptor = -1;
+
+            if (!enabled)
+            {
+                status = "disabled";
+                return;
+            }
+
+#ifdef __linux__
+            int lastError = 0;
+            for (int event = 0; event < PERF_EVENT_COUNT; event++)
+            {
+                descriptors[event] = open(static_cast<PerfEvent>(event));
+                if (descriptors[event] < 0)
+                    lastError = errno;
+            }
+
+            if (!isAvailable())
+                status = std::string("unavailable: ") + std::strerror(lastError)
+                         + (lastError == EACCES || lastError == EPERM
+                            ? " (check /proc/sys/kernel/perf_event_paranoid)" : "");
+            else
+                status = "enabled";
+#else
+            status = "unavailable: perf_event_open is Linux-only";
+#endif
+        }
+
+        ~PerfCounters()
+        {
+#ifdef __linux__
+            for (int descriptor : descriptors)
+                if (descriptor >= 0)
+                    close(descriptor);
+#endif
+        }
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        bool isAvailable() const
+        {
+            for (int descriptor : descriptors)
+                if (descriptor >= 0)
+                    return true;
+            return false;
+        }
+
+        // Human-readable reason when counters are not available.
+        const std::string &getStatus() const
+        {
+            return status;
+        }
+
+        void start()
+        {
+#ifdef __linux__
+            for (int descriptor : descriptors)
+            {
+                if (descriptor < 0)
+                    continue;
+                ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        void stop()
+        {
+#ifdef __linux__
+            for (int descriptor : descriptors)
+                if (descriptor >= 0)
+                    ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+        }
+
+        // Counts since the last start(), scaled up when the kernel had to
+        // multiplex an event with others.
+        PerfSample read() const
+        {
+            PerfSample sample;
+#ifdef __linux__
+            for (int event = 0; event < PERF_EVENT_COUNT; event++)
+            {
+                if (descriptors[event] < 0)
+                    continue;
+
+                std::uint64_t values[3] = {};
+                if (::read(descriptors[event], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)))
+                    continue;
+
+                const std::uint64_t enabled = values[1];
+                const std::uint64_t running = values[2];
+                sample.values[event] = running > 0 ? static_cast<double>(values[0]) * enabled / running : 0;
+                sample.available[event] = true;
+            }
+#endif
+            return sample;
+        }
+
+    private:
+#ifdef __linux__
+        static int open(PerfEvent event)
+        {
+            perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            switch (event)
+            {
+                case PERF_CYCLES:
+                    attributes.type = PERF_TYPE_HARDWARE;
+                    attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+                    break;
+                case PERF_INSTRUCTIONS:
+                    attributes.type = PERF_TYPE_HARDWARE;
+                    attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+                    break;
+                case PERF_L1D_MISSES:
+                    attributes.type = PERF_TYPE_HW_CACHE;
+                    attributes.config = cacheEvent(PERF_COUNT_HW_CACHE_L1D);
+                    break;
+                case PERF_LLC_MISSES:
+                    attributes.type = PERF_TYPE_HW_CACHE;
+                    attributes.config = cacheEvent(PERF_COUNT_HW_CACHE_LL);
+                    break;
+                case PERF_DTLB_MISSES:
+                    attributes.type = PERF_TYPE_HW_CACHE;
+                    attributes.config = cacheEvent(PERF_COUNT_HW_CACHE_DTLB);
+                    break;
+                case PERF_BRANCH_MISSES:
+                    attributes.type = PERF_TYPE_HARDWARE;
+                    attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+                    break;
+                default:
+                    return -1;
+            }
+
+            return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+
+        // Read misses of the given cache, in the encoding perf expects.
+        static std::uint64_t cacheEvent(std::uint64_t cache)
+        {
+            return cache
+                   | (static_cast<std::uint64_t>(PERF_COUNT_HW_CACHE_OP_READ) << 8)
+                   | (static_cast<std::uint64_t>(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+        }
+#endif
+    };
+
+}
+
+#endif // AISDI_LINEAR_PERFCOUNTERS_H
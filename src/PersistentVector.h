@@ -0,0 +1,785 @@
+#ifndef AISDI_LINEAR_PERSISTENTVECTOR_H
+#define AISDI_LINEAR_PERSISTENTVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace aisdi
+{
+
+    // Immutable vector as a relaxed radix balanced (RRB) tree: leaves of up
+    // to 32 elements under branches of up to 32 children, all leaves at one
+    // depth. append, set, concat and slice leave the collection as it is
+    // and return a new version. The new version shares every node off the
+    // path it changed, so a version costs O(log n) time and memory instead
+    // of a copy.
+    //
+    // Branches whose children are all full but the last find a child from
+    // the index bits. Concatenation and slicing leave partial children in
+    // the middle. Those branches are relaxed: they keep a table of their
+    // children's cumulative sizes. Concatenation rebalances the children
+    // it touches, so a lookup takes at most EXTRA_STEPS more steps per
+    // level than a radix search would.
+    //
+    // Nodes are reference counted atomically, so versions may be shared
+    // between threads. A Builder makes many changes in a row without
+    // copying the nodes it has already copied once.
+    template<typename Type>
+    class PersistentVector
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = Type;
+        using const_reference = const Type &;
+
+        class Builder;
+
+    private:
+        static const unsigned BITS = 5;
+        static const unsigned BRANCHING = 1 << BITS;
+        static const unsigned EXTRA_STEPS = 2;
+
+        struct Node
+        {
+            std::atomic<unsigned> references;
+            // 0 for leaves.
+            unsigned height;
+            unsigned count;
+            // The Builder that may change the node in place, 0 for none.
+            std::uint64_t owner;
+
+            Node(unsigned height, std::uint64_t owner)
+                : references(1),
+                  height(height),
+                  count(0),
+                  owner(owner)
+            {}
+        };
+
+        struct Leaf : Node
+        {
+            typename std::aligned_storage<sizeof(Type), alignof(Type)>::type storage[BRANCHING];
+
+            explicit Leaf(std::uint64_t owner)
+                : Node(0, owner)
+            {}
+
+            ~Leaf()
+            {
+                for (unsigned i = 0; i < this->count; i++)
+                    value(i).~Type();
+            }
+
+            Type &value(unsigned index)
+            {
+                return *reinterpret_cast<Type*>(&storage[index]);
+            }
+
+            void add(const Type &item)
+            {
+                new (&storage[this->count]) Type(item);
+                this->count++;
+            }
+        };
+
+        struct Branch : Node
+        {
+            Node *children[BRANCHING];
+            // Cumulative sizes of the children; nullptr unless relaxed.
+            size_type *sizes;
+
+            Branch(unsigned height, std::uint64_t owner)
+                : Node(height, owner),
+                  sizes(nullptr)
+            {}
+
+            ~Branch()
+            {
+                for (unsigned i = 0; i < this->count; i++)
+                    release(children[i]);
+
+                delete [] sizes;
+            }
+        };
+
+        Node *root;
+        size_type size;
+
+        // Takes over a reference to root.
+        PersistentVector(Node *root, size_type size)
+            : root(root),
+              size(size)
+        {}
+
+    public:
+        PersistentVector()
+            : root(nullptr),
+              size(0)
+        {}
+
+        PersistentVector(std::initializer_list<Type> l)
+            : PersistentVector()
+        {
+            Builder builder;
+            for (auto& el : l)
+                builder.append(el);
+
+            *this = builder.persistent();
+        }
+
+        PersistentVector(const PersistentVector &other)
+            : root(retain(other.root)),
+              size(other.size)
+        {}
+
+        PersistentVector(PersistentVector &&other) noexcept
+            : root(other.root),
+              size(other.size)
+        {
+            other.root = nullptr;
+            other.size = 0;
+        }
+
+        ~PersistentVector()
+        {
+            release(root);
+        }
+
+        PersistentVector &operator=(const PersistentVector &other)
+        {
+            Node *previous = root;
+            root = retain(other.root);
+            size = other.size;
+            release(previous);
+
+            return *this;
+        }
+
+        PersistentVector &operator=(PersistentVector &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            release(root);
+            root = other.root;
+            size = other.size;
+            other.root = nullptr;
+            other.size = 0;
+
+            return *this;
+        }
+
+        bool isEmpty() const
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const
+        {
+            return size;
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return valueAt(root, index);
+        }
+
+        const_reference at(size_type index) const
+        {
+            throwIfOutOfRange<std::out_of_range>(index, "index is out of range");
+            return valueAt(root, index);
+        }
+
+        PersistentVector append(const Type &item) const
+        {
+            return PersistentVector(appendTo(root, item, 0), size + 1);
+        }
+
+        PersistentVector set(size_type index, const Type &item) const
+        {
+            throwIfOutOfRange<std::out_of_range>(index, "cannot set past the end");
+            return PersistentVector(setIn(root, index, item, 0), size);
+        }
+
+        PersistentVector concat(const PersistentVector &other) const
+        {
+            if (isEmpty())
+                return other;
+            if (other.isEmpty())
+                return *this;
+
+            return PersistentVector(collapse(concatSubtrees(root, other.root, true)), size + other.size);
+        }
+
+        // Elements [first, last).
+        PersistentVector slice(size_type first, size_type last) const
+        {
+            if (first > last || last > size)
+                throw std::out_of_range("slice is out of range");
+
+            if (first == last)
+                return PersistentVector();
+
+            return PersistentVector(collapse(sliceNode(root, first, last)), last - first);
+        }
+
+        // Calls visit with every element in order, a leaf at a time.
+        template<typename Visit>
+        void forEach(Visit visit) const
+        {
+            if (root != nullptr)
+                visitNode(root, visit);
+        }
+
+    private:
+        static Node *retain(Node *node)
+        {
+            if (node != nullptr)
+                node->references.fetch_add(1, std::memory_order_relaxed);
+
+            return node;
+        }
+
+        static void release(Node *node)
+        {
+            if (node == nullptr || node->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            if (node->height == 0)
+                delete static_cast<Leaf*>(node);
+            else
+                delete static_cast<Branch*>(node);
+        }
+
+        static std::uint64_t nextOwner()
+        {
+            static std::atomic<std::uint64_t> owners(0);
+            return ++owners;
+        }
+
+        // Elements a full child of a branch at height holds.
+        static size_type childCapacity(unsigned height)
+        {
+            return size_type(1) << (BITS * height);
+        }
+
+        static size_type nodeSize(const Node *node)
+        {
+            if (node->height == 0)
+                return node->count;
+
+            const Branch *branch = static_cast<const Branch*>(node);
+            if (branch->sizes != nullptr)
+                return branch->sizes[branch->count - 1];
+
+            return (branch->count - 1) * childCapacity(branch->height) + nodeSize(branch->children[branch->count - 1]);
+        }
+
+        // The child of branch holding index, which becomes relative to it.
+        static unsigned findSlot(const Branch *branch, size_type &index)
+        {
+            const unsigned shift = BITS * branch->height;
+            unsigned slot = static_cast<unsigned>(index >> shift);
+
+            if (branch->sizes == nullptr)
+            {
+                index -= size_type(slot) << shift;
+                return slot;
+            }
+
+            // A relaxed child holds fewer elements than a full one, never
+            // more, so the radix slot is where the search starts.
+            while (branch->sizes[slot] <= index)
+                slot++;
+
+            if (slot > 0)
+                index -= branch->sizes[slot - 1];
+
+            return slot;
+        }
+
+        static const_reference valueAt(Node *node, size_type index)
+        {
+            while (node->height > 0)
+            {
+                const Branch *branch = static_cast<const Branch*>(node);
+                node = branch->children[findSlot(branch, index)];
+            }
+
+            return static_cast<Leaf*>(node)->value(static_cast<unsigned>(index));
+        }
+
+        // The node itself if owner may change it, a copy owned by owner
+        // otherwise.
+        static Node *editable(Node *node, std::uint64_t owner)
+        {
+            if (owner != 0 && node->owner == owner)
+                return node;
+
+            if (node->height == 0)
+            {
+                Leaf *leaf = static_cast<Leaf*>(node);
+                Leaf *copy = new Leaf(owner);
+                for (unsigned i = 0; i < leaf->count; i++)
+                    copy->add(leaf->value(i));
+
+                return copy;
+            }
+
+            Branch *branch = static_cast<Branch*>(node);
+            Branch *copy = new Branch(branch->height, owner);
+            for (unsigned i = 0; i < branch->count; i++)
+                copy->children[i] = retain(branch->children[i]);
+
+            copy->count = branch->count;
+            if (branch->sizes != nullptr)
+            {
+                copy->sizes = new size_type[BRANCHING];
+                for (unsigned i = 0; i < branch->count; i++)
+                    copy->sizes[i] = branch->sizes[i];
+            }
+
+            return copy;
+        }
+
+        // Takes over a reference to child.
+        static void replaceChild(Branch *branch, unsigned slot, Node *child)
+        {
+            if (branch->children[slot] == child)
+                return;
+
+            release(branch->children[slot]);
+            branch->children[slot] = child;
+        }
+
+        // Takes over a reference to child.
+        static void addChild(Branch *branch, Node *child)
+        {
+            // Past a partial child the index bits no longer find slots.
+            if (branch->sizes == nullptr && branch->count > 0
+                && nodeSize(branch->children[branch->count - 1]) != childCapacity(branch->height))
+            {
+                branch->sizes = new size_type[BRANCHING];
+                size_type total = 0;
+                for (unsigned i = 0; i < branch->count; i++)
+                    branch->sizes[i] = total += nodeSize(branch->children[i]);
+            }
+
+            if (branch->sizes != nullptr)
+                branch->sizes[branch->count] = (branch->count > 0 ? branch->sizes[branch->count - 1] : 0)
+                                               + nodeSize(child);
+
+            branch->children[branch->count] = child;
+            branch->count++;
+        }
+
+        // A single item at height, under one-child branches.
+        static Node *newPath(unsigned height, const Type &item, std::uint64_t owner)
+        {
+            Leaf *leaf = new Leaf(owner);
+            leaf->add(item);
+
+            Node *node = leaf;
+            for (unsigned level = 1; level <= height; level++)
+            {
+                Branch *branch = new Branch(level, owner);
+                addChild(branch, node);
+                node = branch;
+            }
+
+            return node;
+        }
+
+        // Returns node with the value set, which is node itself if owner
+        // may change it.
+        static Node *setIn(Node *node, size_type index, const Type &item, std::uint64_t owner)
+        {
+            if (node->height == 0)
+            {
+                Leaf *leaf = static_cast<Leaf*>(editable(node, owner));
+                leaf->value(static_cast<unsigned>(index)) = item;
+                return leaf;
+            }
+
+            Branch *branch = static_cast<Branch*>(editable(node, owner));
+            unsigned slot = findSlot(branch, index);
+            replaceChild(branch, slot, setIn(branch->children[slot], index, item, owner));
+            return branch;
+        }
+
+        // Adds item on the rightmost path of node, or returns nullptr,
+        // having copied nothing, when that path has no room.
+        static Node *pushBack(Node *node, const Type &item, std::uint64_t owner)
+        {
+            if (node->height == 0)
+            {
+                if (node->count == BRANCHING)
+                    return nullptr;
+
+                Leaf *leaf = static_cast<Leaf*>(editable(node, owner));
+                leaf->add(item);
+                return leaf;
+            }
+
+            Branch *branch = static_cast<Branch*>(node);
+            Node *grown = pushBack(branch->children[branch->count - 1], item, owner);
+
+            if (grown == nullptr)
+            {
+                if (branch->count == BRANCHING)
+                    return nullptr;
+
+                branch = static_cast<Branch*>(editable(branch, owner));
+                addChild(branch, newPath(branch->height - 1, item, owner));
+                return branch;
+            }
+
+            branch = static_cast<Branch*>(editable(branch, owner));
+            replaceChild(branch, branch->count - 1, grown);
+            if (branch->sizes != nullptr)
+                branch->sizes[branch->count - 1]++;
+
+            return branch;
+        }
+
+        // Returns the root with item appended, which is root itself if
+        // owner may change it.
+        static Node *appendTo(Node *root, const Type &item, std::uint64_t owner)
+        {
+            if (root == nullptr)
+                return newPath(0, item, owner);
+
+            Node *grown = pushBack(root, item, owner);
+            if (grown != nullptr)
+                return grown;
+
+            Branch *top = new Branch(root->height + 1, owner);
+            addChild(top, retain(root));
+            addChild(top, newPath(root->height, item, owner));
+            return top;
+        }
+
+        // Drops one-child branches from the top. Takes over a reference to
+        // node.
+        static Node *collapse(Node *node)
+        {
+            while (node->height > 0 && node->count == 1)
+            {
+                Node *child = retain(static_cast<Branch*>(node)->children[0]);
+                release(node);
+                node = child;
+            }
+
+            return node;
+        }
+
+        // Concatenation after L'orange, "Improving RRB-Tree Performance
+        // through Transience": joins the rightmost path of left with the
+        // leftmost path of right level by level, from the leaves up, and
+        // rebalances the nodes along the seam. Returns a branch one level
+        // above the taller tree, or at its level when top and that is
+        // enough.
+        static Branch *concatSubtrees(Node *left, Node *right, bool top)
+        {
+            if (left->height > right->height)
+            {
+                Branch *leftBranch = static_cast<Branch*>(left);
+                Branch *middle = concatSubtrees(leftBranch->children[leftBranch->count - 1], right, false);
+                return rebalance(leftBranch, middle, nullptr, top);
+            }
+
+            if (left->height < right->height)
+            {
+                Branch *rightBranch = static_cast<Branch*>(right);
+                Branch *middle = concatSubtrees(left, rightBranch->children[0], false);
+                return rebalance(nullptr, middle, rightBranch, top);
+            }
+
+            if (left->height == 0)
+            {
+                Branch *joined = new Branch(1, 0);
+                if (top && left->count + right->count <= BRANCHING)
+                {
+                    Leaf *leaf = new Leaf(0);
+                    for (unsigned i = 0; i < left->count; i++)
+                        leaf->add(static_cast<Leaf*>(left)->value(i));
+                    for (unsigned i = 0; i < right->count; i++)
+                        leaf->add(static_cast<Leaf*>(right)->value(i));
+
+                    addChild(joined, leaf);
+                }
+                else
+                {
+                    addChild(joined, retain(left));
+                    addChild(joined, retain(right));
+                }
+
+                return joined;
+            }
+
+            Branch *leftBranch = static_cast<Branch*>(left);
+            Branch *rightBranch = static_cast<Branch*>(right);
+            Branch *middle = concatSubtrees(leftBranch->children[leftBranch->count - 1],
+                                            rightBranch->children[0], false);
+            return rebalance(leftBranch, middle, rightBranch, top);
+        }
+
+        // Repacks the children of left but its last, of middle and of right
+        // but its first, which are one level below middle, into as few
+        // nodes as the invariant asks for. Takes over the reference to
+        // middle.
+        static Branch *rebalance(Branch *left, Branch *middle, Branch *right, bool top)
+        {
+            std::vector<Node*> slots;
+            if (left != nullptr)
+                slots.insert(slots.end(), left->children, left->children + left->count - 1);
+            slots.insert(slots.end(), middle->children, middle->children + middle->count);
+            if (right != nullptr)
+                slots.insert(slots.end(), right->children + 1, right->children + right->count);
+
+            const unsigned height = middle->height;
+            std::vector<Node*> nodes = executePlan(slots, concatenationPlan(slots), height - 1);
+            release(middle);
+
+            Branch *packed = new Branch(height, 0);
+            unsigned next = 0;
+            for (; next < nodes.size() && next < BRANCHING; next++)
+                addChild(packed, nodes[next]);
+
+            if (next == nodes.size() && top)
+                return packed;
+
+            Branch *parent = new Branch(height + 1, 0);
+            addChild(parent, packed);
+
+            if (next < nodes.size())
+            {
+                Branch *rest = new Branch(height, 0);
+                for (; next < nodes.size(); next++)
+                    addChild(rest, nodes[next]);
+
+                addChild(parent, rest);
+            }
+
+            return parent;
+        }
+
+        // Slot counts of the nodes to pack slots into. Merges the first
+        // underfull node into the ones after it, shifting their slots
+        // left, until the nodes are at most EXTRA_STEPS more than the
+        // fewest that could hold everything.
+        static std::vector<unsigned> concatenationPlan(const std::vector<Node*> &slots)
+        {
+            std::vector<unsigned> counts;
+            size_type total = 0;
+            for (const Node *node : slots)
+            {
+                counts.push_back(node->count);
+                total += node->count;
+            }
+
+            const size_type optimal = (total + BRANCHING - 1) / BRANCHING;
+            size_type i = 0;
+
+            while (optimal + EXTRA_STEPS < counts.size())
+            {
+                while (counts[i] >= BRANCHING - EXTRA_STEPS / 2)
+                    i++;
+
+                unsigned remaining = counts[i];
+                do
+                {
+                    unsigned filled = remaining + counts[i + 1] < BRANCHING ? remaining + counts[i + 1] : BRANCHING;
+                    remaining = remaining + counts[i + 1] - filled;
+                    counts[i] = filled;
+                    i++;
+                }
+                while (remaining > 0);
+
+                counts.erase(counts.begin() + i);
+                i--;
+            }
+
+            return counts;
+        }
+
+        // Nodes at height with the given slot counts, holding the children
+        // or elements of slots in order. Nodes that already have the
+        // planned count are reused.
+        static std::vector<Node*> executePlan(const std::vector<Node*> &slots, const std::vector<unsigned> &counts,
+                                              unsigned height)
+        {
+            std::vector<Node*> nodes;
+            size_type source = 0;
+            unsigned offset = 0;
+
+            for (unsigned count : counts)
+            {
+                if (offset == 0 && slots[source]->count == count)
+                {
+                    nodes.push_back(retain(slots[source++]));
+                    continue;
+                }
+
+                Node *node = height == 0 ? static_cast<Node*>(new Leaf(0)) : new Branch(height, 0);
+                while (node->count < count)
+                {
+                    if (height == 0)
+                        static_cast<Leaf*>(node)->add(static_cast<Leaf*>(slots[source])->value(offset));
+                    else
+                        addChild(static_cast<Branch*>(node), retain(static_cast<Branch*>(slots[source])->children[offset]));
+
+                    if (++offset == slots[source]->count)
+                    {
+                        source++;
+                        offset = 0;
+                    }
+                }
+
+                nodes.push_back(node);
+            }
+
+            return nodes;
+        }
+
+        // Elements [first, last) of node, which must not be empty. Shares
+        // the children that lie entirely inside.
+        static Node *sliceNode(Node *node, size_type first, size_type last)
+        {
+            if (first == 0 && last == nodeSize(node))
+                return retain(node);
+
+            if (node->height == 0)
+            {
+                Leaf *leaf = new Leaf(0);
+                for (size_type i = first; i < last; i++)
+                    leaf->add(static_cast<Leaf*>(node)->value(static_cast<unsigned>(i)));
+
+                return leaf;
+            }
+
+            const Branch *branch = static_cast<const Branch*>(node);
+            Branch *sliced = new Branch(branch->height, 0);
+            size_type start = 0;
+
+            for (unsigned slot = 0; slot < branch->count && start < last; slot++)
+            {
+                const size_type end = start + nodeSize(branch->children[slot]);
+                if (end > first)
+                    addChild(sliced, sliceNode(branch->children[slot], first > start ? first - start : 0,
+                                               (last < end ? last : end) - start));
+                start = end;
+            }
+
+            return sliced;
+        }
+
+        template<typename Visit>
+        static void visitNode(Node *node, Visit &visit)
+        {
+            if (node->height == 0)
+            {
+                Leaf *leaf = static_cast<Leaf*>(node);
+                for (unsigned i = 0; i < leaf->count; i++)
+                    visit(static_cast<const_reference>(leaf->value(i)));
+
+                return;
+            }
+
+            const Branch *branch = static_cast<const Branch*>(node);
+            for (unsigned i = 0; i < branch->count; i++)
+                visitNode(branch->children[i], visit);
+        }
+
+        template <typename Exception>
+        void throwIfOutOfRange(size_type index, const char *message) const
+        {
+            if (index >= size)
+                throw Exception(message);
+        }
+    };
+
+    // Transient version of a PersistentVector for changes in bulk. The
+    // first change to a node copies it as usual, and the copy belongs to
+    // the builder, which then changes it in place. persistent() publishes
+    // the nodes, so that further changes copy them again. A Builder is
+    // meant for one thread at a time.
+    template<typename Type>
+    class PersistentVector<Type>::Builder
+    {
+        Node *root;
+        size_type size;
+        std::uint64_t owner;
+
+    public:
+        Builder()
+            : root(nullptr),
+              size(0),
+              owner(nextOwner())
+        {}
+
+        explicit Builder(const PersistentVector &version)
+            : root(retain(version.root)),
+              size(version.size),
+              owner(nextOwner())
+        {}
+
+        Builder(const Builder &) = delete;
+        Builder &operator=(const Builder &) = delete;
+
+        ~Builder()
+        {
+            release(root);
+        }
+
+        size_type getSize() const
+        {
+            return size;
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return valueAt(root, index);
+        }
+
+        void append(const Type &item)
+        {
+            replaceRoot(appendTo(root, item, owner));
+            size++;
+        }
+
+        void set(size_type index, const Type &item)
+        {
+            if (index >= size)
+                throw std::out_of_range("cannot set past the end");
+
+            replaceRoot(setIn(root, index, item, owner));
+        }
+
+        PersistentVector persistent()
+        {
+            owner = nextOwner();
+            return PersistentVector(retain(root), size);
+        }
+
+    private:
+        // Takes over a reference to next.
+        void replaceRoot(Node *next)
+        {
+            if (next == root)
+                return;
+
+            release(root);
+            root = next;
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_PERSISTENTVECTOR_H
@@ -0,0 +1,52 @@
+#ifndef AISDI_LINEAR_PREFETCHWALK_H
+#define AISDI_LINEAR_PREFETCHWALK_H
+
+#include <cstddef>
+
+namespace aisdi
+{
+
+    // Calls visit on every node of the chain [first, last), linked through
+    // next, in order. Reads a node's successor before visiting it, so visit
+    // may destroy it. With distance > 0, keeps a pointer distance nodes
+    // ahead and calls prefetch on every node it moves onto; with 0, never
+    // looks past the node being visited.
+    template<typename Node, typename Visit, typename Prefetch>
+    void walkPrefetching(Node *first, Node *last, std::size_t distance, Visit visit, Prefetch prefetch)
+    {
+        if (distance == 0)
+        {
+            for (Node *node = first; node != last; )
+            {
+                Node *next = node->next;
+                visit(node);
+                node = next;
+            }
+
+            return;
+        }
+
+        Node *ahead = first;
+        for (std::size_t i = 0; i < distance && ahead != last; i++)
+        {
+            ahead = ahead->next;
+            prefetch(ahead);
+        }
+
+        for (Node *node = first; node != last; )
+        {
+            Node *next = node->next;
+            if (ahead != last)
+            {
+                ahead = ahead->next;
+                prefetch(ahead);
+            }
+
+            visit(node);
+            node = next;
+        }
+    }
+
+}
+
+#endif // AISDI_LINEAR_PREFETCHWALK_H
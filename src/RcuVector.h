@@ -0,0 +1,211 @@
+#ifndef AISDI_LINEAR_RCUVECTOR_H
+#define AISDI_LINEAR_RCUVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "SharedVector.h"
+
+namespace aisdi
+{
+
+    // Read-mostly collection in the manner of read-copy-update. Readers
+    // see an immutable version and never block: reading is two atomic
+    // stores and two loads around the visit, however busy the writer. A
+    // writer copies the current version, changes the copy and publishes
+    // it with one exchange. Versions are SharedVectors, so copying one is
+    // O(1) and the change clones the storage once.
+    //
+    // Replaced versions are freed after a grace period, tracked with
+    // epochs: every publish advances the global epoch, a reader records
+    // the epoch it started in, and a version replaced in epoch e is freed
+    // once no reader is still in an epoch <= e. Writers check for that on
+    // every publish, or wait for it in synchronize().
+    template<typename Type>
+    class RcuVector
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = Type;
+        using Version = SharedVector<Type>;
+
+        class Reader;
+
+    private:
+        static const size_type CACHE_LINE = 64;
+        // Recorded by readers that are not reading.
+        static const std::uint64_t QUIESCENT = ~std::uint64_t(0);
+
+        struct Retired
+        {
+            std::uint64_t epoch;
+            const Version *version;
+        };
+
+        std::atomic<const Version*> current;
+        std::atomic<std::uint64_t> epoch;
+        char padding[CACHE_LINE];
+
+        std::mutex readersMutex;
+        std::vector<std::unique_ptr<Reader>> readers;
+
+        mutable std::mutex writerMutex;
+        std::vector<Retired> retired;
+
+    public:
+        explicit RcuVector(Version initial = Version())
+            : current(new Version(std::move(initial))),
+              epoch(0)
+        {}
+
+        RcuVector(const RcuVector &) = delete;
+        RcuVector &operator=(const RcuVector &) = delete;
+
+        // Must not race with readers or writers.
+        ~RcuVector()
+        {
+            for (const Retired &version : retired)
+                delete version.version;
+
+            delete current.load(std::memory_order_acquire);
+        }
+
+        // Safe from any thread. The reader lives as long as the collection.
+        Reader &addReader()
+        {
+            std::lock_guard<std::mutex> lock(readersMutex);
+            readers.emplace_back(new Reader(*this));
+            return *readers.back();
+        }
+
+        // Calls update with a copy of the current version and publishes
+        // the result. Safe from any thread; writers take turns.
+        template<typename Update>
+        void update(Update update)
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            std::unique_ptr<Version> next(new Version(*current.load(std::memory_order_relaxed)));
+            update(*next);
+            replace(next.release());
+        }
+
+        void publish(Version version)
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            replace(new Version(std::move(version)));
+        }
+
+        // Waits until every replaced version is freed, that is until the
+        // readers that started before the last publish are done.
+        void synchronize()
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            while (!reclaim())
+                std::this_thread::yield();
+        }
+
+        // Replaced versions that readers may still see.
+        size_type getRetiredCount() const
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            return retired.size();
+        }
+
+    private:
+        void replace(const Version *next)
+        {
+            const Version *previous = current.exchange(next);
+            retired.push_back({epoch.fetch_add(1), previous});
+            reclaim();
+        }
+
+        // Frees the versions no reader can see any more. Returns whether
+        // none are left.
+        bool reclaim()
+        {
+            const std::uint64_t oldest = oldestReadingEpoch();
+            size_type kept = 0;
+
+            for (const Retired &version : retired)
+            {
+                if (version.epoch < oldest)
+                    delete version.version;
+                else
+                    retired[kept++] = version;
+            }
+
+            retired.resize(kept);
+            return retired.empty();
+        }
+
+        std::uint64_t oldestReadingEpoch()
+        {
+            std::lock_guard<std::mutex> lock(readersMutex);
+            std::uint64_t oldest = QUIESCENT;
+
+            for (const std::unique_ptr<Reader> &reader : readers)
+            {
+                std::uint64_t reading = reader->reading.load();
+                oldest = reading < oldest ? reading : oldest;
+            }
+
+            return oldest;
+        }
+    };
+
+    // A thread's handle for reading. Each Reader is meant for one thread at
+    // a time.
+    template<typename Type>
+    class RcuVector<Type>::Reader
+    {
+        RcuVector &collection;
+        // Keeps the epoch, written on every read, off the lines of other
+        // readers' epochs.
+        char padding[CACHE_LINE];
+        std::atomic<std::uint64_t> reading;
+
+        explicit Reader(RcuVector &collection)
+            : collection(collection),
+              reading(QUIESCENT)
+        {}
+
+        struct Quiesce
+        {
+            std::atomic<std::uint64_t> &reading;
+
+            ~Quiesce()
+            {
+                reading.store(QUIESCENT, std::memory_order_release);
+            }
+        };
+
+    public:
+        Reader(const Reader &) = delete;
+        Reader &operator=(const Reader &) = delete;
+
+        // Calls visit with the current version, which stays alive and
+        // unchanged until visit returns. Not reentrant.
+        //
+        // The epoch is recorded before the version is loaded, both
+        // sequentially consistent, so a writer that finds no reader in an
+        // old epoch knows every reader has loaded a newer version.
+        template<typename Visit>
+        void read(Visit visit)
+        {
+            reading.store(collection.epoch.load(std::memory_order_acquire));
+            Quiesce quiesce{reading};
+            visit(*collection.current.load());
+        }
+
+        friend class RcuVector;
+    };
+
+}
+
+#endif // AISDI_LINEAR_RCUVECTOR_H
@@ -0,0 +1,54 @@
+#ifndef AISDI_LINEAR_SEGMENTINDEX_H
+#define AISDI_LINEAR_SEGMENTINDEX_H
+
+#include <cstddef>
+
+namespace aisdi
+{
+
+    // Where index i lives in a table of segments that double in size:
+    // segment k holds FIRST_SEGMENT_SIZE << k elements, so no segment ever
+    // has to move and segments 0..k-1 hold FIRST_SEGMENT_SIZE * (2^k - 1).
+    // Shifted by FIRST_SEGMENT_SIZE, an index has its segment in the
+    // position of its highest bit and its offset in the bits below, which
+    // takes a single bit scan to find.
+    template<unsigned FirstSegmentBits>
+    struct SegmentIndex
+    {
+        using size_type = std::size_t;
+
+        static const size_type FIRST_SEGMENT_SIZE = size_type(1) << FirstSegmentBits;
+        static const unsigned MAX_SEGMENTS = 8 * sizeof(size_type) - FirstSegmentBits;
+
+        unsigned segment;
+        size_type offset;
+
+        static SegmentIndex locate(size_type index)
+        {
+            size_type shifted = index + FIRST_SEGMENT_SIZE;
+            unsigned highestBit = 8 * sizeof(unsigned long long) - 1
+                                  - static_cast<unsigned>(__builtin_clzll(shifted));
+            return SegmentIndex{highestBit - FirstSegmentBits, shifted - (size_type(1) << highestBit)};
+        }
+
+        static size_type capacityOf(unsigned segment)
+        {
+            return FIRST_SEGMENT_SIZE << segment;
+        }
+
+        // Elements held by the first count segments together.
+        static size_type totalCapacityOf(unsigned count)
+        {
+            return FIRST_SEGMENT_SIZE * ((size_type(1) << count) - 1);
+        }
+
+        static bool startsSegment(size_type index)
+        {
+            size_type shifted = index + FIRST_SEGMENT_SIZE;
+            return (shifted & (shifted - 1)) == 0;
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_SEGMENTINDEX_H
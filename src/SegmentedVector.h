@@ -0,0 +1,600 @@
+#ifndef AISDI_LINEAR_SEGMENTEDVECTOR_H
+#define AISDI_LINEAR_SEGMENTEDVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "SegmentIndex.h"
+
+namespace aisdi
+{
+
+    // Vector whose storage is a table of segments doubling in size (see
+    // SegmentIndex) instead of one buffer. Growing allocates the next
+    // segment and never copies elements, so no append costs more than one
+    // allocation and pointers to elements stay valid as the collection
+    // grows. Inserts and erases still shift the elements after them, as in
+    // Vector, and segments are only freed with the collection.
+    template<typename Type>
+    class SegmentedVector
+    {
+    public:
+        class ConstIterator;
+        class Iterator;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type *;
+        using reference = Type &;
+        using const_pointer = const Type *;
+        using const_reference = const Type &;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+    private:
+        using Position = SegmentIndex<4>;
+
+        pointer segments[Position::MAX_SEGMENTS];
+        unsigned segmentCount;
+        size_type size;
+
+    public:
+        explicit SegmentedVector()
+            : segmentCount(0),
+              size(0)
+        {}
+
+        SegmentedVector(std::initializer_list<Type> l)
+            : SegmentedVector()
+        {
+            copyFrom(l);
+        }
+
+        SegmentedVector(const SegmentedVector &other)
+            : SegmentedVector()
+        {
+            copyFrom(other);
+        }
+
+        SegmentedVector(SegmentedVector &&other) noexcept
+            : SegmentedVector()
+        {
+            moveFrom(other);
+        }
+
+        ~SegmentedVector()
+        {
+            destroyElements();
+            freeSegments();
+        }
+
+        SegmentedVector &operator=(const SegmentedVector &other)
+        {
+            if (this == &other)
+                return *this;
+
+            destroyElements();
+            copyFrom(other);
+
+            return *this;
+        }
+
+        SegmentedVector &operator=(SegmentedVector &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            destroyElements();
+            freeSegments();
+            moveFrom(other);
+
+            return *this;
+        }
+
+        bool isEmpty() const
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const
+        {
+            return size;
+        }
+
+        size_type getCapacity() const
+        {
+            return Position::totalCapacityOf(segmentCount);
+        }
+
+        reference operator[](size_type index)
+        {
+            return *slotAt(index);
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return *slotAt(index);
+        }
+
+        void append(const Type &item)
+        {
+            addSegmentIfFull();
+            new (slotAt(size)) Type(item);
+            size++;
+        }
+
+        void prepend(const Type &item)
+        {
+            insertAt(0, item);
+        }
+
+        void insert(const const_iterator &insertPosition, const Type &item)
+        {
+            insertAt(insertPosition.getIndex(), item);
+        }
+
+        Type popFirst()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popFirst when collection is empty");
+
+            Type value = std::move(*slotAt(0));
+            eraseAt(0);
+            return value;
+        }
+
+        Type popLast()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popLast when collection is empty");
+
+            pointer last = slotAt(size - 1);
+            Type value = std::move(*last);
+            last->~Type();
+            size--;
+            return value;
+        }
+
+        void erase(const const_iterator &position)
+        {
+            throwIfCollectionEmpty<std::out_of_range>(
+                    "cannot erase from empty collection");
+
+            throwIfIteratorEqualsEnd<std::out_of_range>(
+                    position,
+                    "cannot erase end");
+
+            eraseAt(position.getIndex());
+        }
+
+        void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+        {
+            if (firstIncluded == lastExcluded)
+                return;
+
+            size_type first = firstIncluded.getIndex();
+            size_type count = lastExcluded.getIndex() - first;
+
+            moveTowardsFront(first + count, first, size - first - count);
+
+            for (size_type i = size - count; i < size; i++)
+                slotAt(i)->~Type();
+
+            size -= count;
+        }
+
+        iterator begin()
+        {
+            return Iterator(this, 0);
+        }
+
+        iterator end()
+        {
+            return Iterator(this, size);
+        }
+
+        const_iterator cbegin() const
+        {
+            return ConstIterator(this, 0);
+        }
+
+        const_iterator cend() const
+        {
+            return ConstIterator(this, size);
+        }
+
+        const_iterator begin() const
+        {
+            return cbegin();
+        }
+
+        const_iterator end() const
+        {
+            return cend();
+        }
+
+    private:
+        pointer slotAt(size_type index) const
+        {
+            Position position = Position::locate(index);
+            return segments[position.segment] + position.offset;
+        }
+
+        // Like slotAt, but nullptr past the allocated segments.
+        pointer slotOrNull(size_type index) const
+        {
+            Position position = Position::locate(index);
+            return position.segment < segmentCount ? segments[position.segment] + position.offset : nullptr;
+        }
+
+        void addSegmentIfFull()
+        {
+            if (size < getCapacity())
+                return;
+
+            segments[segmentCount] = static_cast<pointer>(
+                    ::operator new(Position::capacityOf(segmentCount) * sizeof(Type)));
+            segmentCount++;
+        }
+
+        void insertAt(size_type index, const Type &item)
+        {
+            if (index == size)
+                return append(item);
+
+            addSegmentIfFull();
+            new (slotAt(size)) Type(std::move(*slotAt(size - 1)));
+            size++;
+
+            moveTowardsBack(index, index + 1, size - 2 - index);
+
+            *slotAt(index) = item;
+        }
+
+        void eraseAt(size_type index)
+        {
+            moveTowardsFront(index + 1, index, size - index - 1);
+
+            slotAt(size - 1)->~Type();
+            size--;
+        }
+
+        // Move-assigns count elements from index from to index to < from,
+        // in runs that stay within one source and one target segment.
+        void moveTowardsFront(size_type from, size_type to, size_type count)
+        {
+            while (count > 0)
+            {
+                Position source = Position::locate(from);
+                Position target = Position::locate(to);
+                size_type run = std::min({count,
+                                          Position::capacityOf(source.segment) - source.offset,
+                                          Position::capacityOf(target.segment) - target.offset});
+
+                pointer first = segments[source.segment] + source.offset;
+                std::move(first, first + run, segments[target.segment] + target.offset);
+
+                from += run;
+                to += run;
+                count -= run;
+            }
+        }
+
+        // As moveTowardsFront, for to > from, starting from the last element.
+        void moveTowardsBack(size_type from, size_type to, size_type count)
+        {
+            while (count > 0)
+            {
+                Position source = Position::locate(from + count - 1);
+                Position target = Position::locate(to + count - 1);
+                size_type run = std::min({count, source.offset + 1, target.offset + 1});
+
+                pointer last = segments[source.segment] + source.offset + 1;
+                std::move_backward(last - run, last, segments[target.segment] + target.offset + 1);
+
+                count -= run;
+            }
+        }
+
+        void destroyElements()
+        {
+            for (size_type i = 0; i < size; i++)
+                slotAt(i)->~Type();
+
+            size = 0;
+        }
+
+        void freeSegments()
+        {
+            for (unsigned segment = 0; segment < segmentCount; segment++)
+                ::operator delete(segments[segment]);
+
+            segmentCount = 0;
+        }
+
+        template<class Collection>
+        void copyFrom(const Collection &collection)
+        {
+            for (auto& el : collection)
+                append(el);
+        }
+
+        void moveFrom(SegmentedVector &other)
+        {
+            for (unsigned segment = 0; segment < other.segmentCount; segment++)
+                segments[segment] = other.segments[segment];
+
+            segmentCount = other.segmentCount;
+            size = other.size;
+            other.segmentCount = 0;
+            other.size = 0;
+        }
+
+        template <typename Exception>
+        void throwIfCollectionEmpty(const char *message) const
+        {
+            if (isEmpty())
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfIteratorEqualsEnd(const ConstIterator &iterator, const char *message) const
+        {
+            if (iterator.getIndex() >= size)
+                throw Exception(message);
+        }
+    };
+
+    // Keeps a pointer to its element next to the index, so stepping through
+    // a segment is a pointer increment and only crossing into the next
+    // segment looks the table up.
+    template<typename Type>
+    class SegmentedVector<Type>::ConstIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename SegmentedVector::value_type;
+        using difference_type = typename SegmentedVector::difference_type;
+        using pointer = typename SegmentedVector::const_pointer;
+        using reference = typename SegmentedVector::const_reference;
+        using size_type = typename SegmentedVector::size_type;
+
+        friend class SegmentedVector;
+
+    private:
+        const SegmentedVector *collection;
+        size_type index;
+        typename SegmentedVector::pointer element;
+
+    public:
+        explicit ConstIterator(const SegmentedVector *collection, size_type index)
+            : collection(collection),
+              index(index),
+              element(collection->slotOrNull(index))
+        {}
+
+        ConstIterator()
+            : collection(nullptr),
+              index(0),
+              element(nullptr)
+        {}
+
+        reference operator*() const
+        {
+            throwIfEnd<std::out_of_range>(
+                    "end iterator cannot be dereferenced");
+
+            return *element;
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+
+        ConstIterator &operator++()
+        {
+            throwIfEnd<std::out_of_range>(
+                    "cannot increment end iterator");
+
+            index++;
+            element = Position::startsSegment(index) ? collection->slotOrNull(index) : element + 1;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator old = *this;
+            operator++();
+            return old;
+        }
+
+        ConstIterator &operator--()
+        {
+            throwIfBegin<std::out_of_range>(
+                    "cannot decrement begin iterator");
+
+            element = Position::startsSegment(index) ? collection->slotOrNull(index - 1) : element - 1;
+            index--;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator old = *this;
+            operator--();
+            return old;
+        }
+
+        ConstIterator &operator+=(difference_type d)
+        {
+            index += d;
+            element = collection->slotOrNull(index);
+            return *this;
+        }
+
+        ConstIterator &operator-=(difference_type d)
+        {
+            return operator+=(-d);
+        }
+
+        ConstIterator operator+(difference_type d) const
+        {
+            return ConstIterator(collection, index + d);
+        }
+
+        ConstIterator operator-(difference_type d) const
+        {
+            return ConstIterator(collection, index - d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const ConstIterator &other) const
+        {
+            return collection == other.collection && index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const
+        {
+            return !operator==(other);
+        }
+
+        bool operator<(const ConstIterator &other) const
+        {
+            return index < other.index;
+        }
+
+        bool operator>(const ConstIterator &other) const
+        {
+            return other < *this;
+        }
+
+        bool operator<=(const ConstIterator &other) const
+        {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ConstIterator &other) const
+        {
+            return !(*this < other);
+        }
+
+    protected:
+        size_type getIndex() const
+        {
+            return index;
+        }
+
+        template <typename Exception>
+        void throwIfBegin(const char *message) const
+        {
+            if (index == 0)
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfEnd(const char *message) const
+        {
+            if (index >= collection->getSize())
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    class SegmentedVector<Type>::Iterator : public SegmentedVector<Type>::ConstIterator
+    {
+    public:
+        using pointer = typename SegmentedVector::pointer;
+        using reference = typename SegmentedVector::reference;
+        using size_type = typename SegmentedVector::size_type;
+
+        explicit Iterator(SegmentedVector *collection, size_type index)
+            : ConstIterator(collection, index)
+        {}
+
+        Iterator()
+        {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other)
+        {}
+
+        Iterator &operator++()
+        {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--()
+        {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator &operator+=(difference_type d)
+        {
+            ConstIterator::operator+=(d);
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type d)
+        {
+            ConstIterator::operator-=(d);
+            return *this;
+        }
+
+        Iterator operator+(difference_type d) const
+        {
+            return ConstIterator::operator+(d);
+        }
+
+        Iterator operator-(difference_type d) const
+        {
+            return ConstIterator::operator-(d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return ConstIterator::operator-(other);
+        }
+
+        reference operator*() const
+        {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_SEGMENTEDVECTOR_H
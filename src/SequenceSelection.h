@@ -0,0 +1,76 @@
+#ifndef AISDI_LINEAR_SEQUENCESELECTION_H
+#define AISDI_LINEAR_SEQUENCESELECTION_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Vector.h"
+#include "LinkedList.h"
+
+namespace aisdi
+{
+
+    enum class AccessPattern
+    {
+        FRONT_INSERT,
+        INSERT_NEAR_FRONT,      // at begin() + size/10
+        MIDDLE_INSERT,          // at begin() + size/2
+        INSERT_NEAR_BACK,       // at begin() + 9*size/10
+        ERASE_WHILE_ITERATING   // every other element, in one pass
+    };
+
+    // From which collection size a LinkedList was measured to beat a Vector
+    // for a pattern and element size. ALWAYS and NEVER mark a winner that
+    // did not change over the whole searched range.
+    struct CrossoverThreshold
+    {
+        static constexpr std::size_t ALWAYS = 0;
+        static constexpr std::size_t NEVER = static_cast<std::size_t>(-1);
+
+        AccessPattern pattern;
+        std::size_t elementBytes;
+        std::size_t listFromSize;
+    };
+
+}
+
+#include "CrossoverTable.h"
+
+namespace aisdi
+{
+
+    namespace detail
+    {
+
+        // Entries of a pattern are sorted by element size. Picks the largest
+        // element size not above bytes, or the smallest if all are above.
+        constexpr const CrossoverThreshold *findCrossover(AccessPattern pattern, std::size_t bytes,
+                                                          std::size_t i = 0, const CrossoverThreshold *found = nullptr)
+        {
+            return i == sizeof(crossoverThresholds) / sizeof(crossoverThresholds[0])
+                   ? found
+                   : findCrossover(pattern, bytes, i + 1,
+                                   crossoverThresholds[i].pattern == pattern
+                                   && (found == nullptr || crossoverThresholds[i].elementBytes <= bytes)
+                                   ? &crossoverThresholds[i] : found);
+        }
+
+    }
+
+    constexpr bool prefersLinkedList(AccessPattern pattern, std::size_t elementBytes, std::size_t expectedSize)
+    {
+        return detail::findCrossover(pattern, elementBytes) != nullptr
+               && detail::findCrossover(pattern, elementBytes)->listFromSize != CrossoverThreshold::NEVER
+               && expectedSize >= detail::findCrossover(pattern, elementBytes)->listFromSize;
+    }
+
+    // Picks LinkedList or Vector at compile time from the measured
+    // crossovers (see "aisdiLinear crossover"), e.g.
+    //   PreferredSequence<Order, AccessPattern::MIDDLE_INSERT, 5000> orders;
+    template<typename Type, AccessPattern pattern, std::size_t expectedSize>
+    using PreferredSequence = typename std::conditional<prefersLinkedList(pattern, sizeof(Type), expectedSize),
+                                                        LinkedList<Type>, Vector<Type>>::type;
+
+}
+
+#endif // AISDI_LINEAR_SEQUENCESELECTION_H
@@ -0,0 +1,589 @@
+#ifndef AISDI_LINEAR_SHAREDVECTOR_H
+#define AISDI_LINEAR_SHAREDVECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace aisdi
+{
+
+    // Vector with copy-on-write storage. Copies share one buffer and bump
+    // its reference count, so passing the collection by value is O(1); the
+    // first modification through a handle whose buffer is shared clones the
+    // buffer for that handle alone.
+    //
+    // The reference count is atomic: handles sharing a buffer may be read,
+    // copied, modified and destroyed in different threads, as long as each
+    // handle is used by one thread at a time, as with std::shared_ptr.
+    // Non-const begin(), end() and operator[] count as modifications; the
+    // iterators and references they return must not be kept past a copy
+    // of the collection, or writes through them would show in the copy.
+    template<typename Type>
+    class SharedVector
+    {
+    public:
+        class ConstIterator;
+        class Iterator;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type *;
+        using reference = Type &;
+        using const_pointer = const Type *;
+        using const_reference = const Type &;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+    private:
+        static const size_type DEFAULT_INITIAL_CAPACITY = 30;
+
+        struct Buffer
+        {
+            std::atomic<size_type> references;
+            size_type size;
+            size_type capacity;
+            pointer elements;
+
+            explicit Buffer(size_type capacity)
+                : references(1),
+                  size(0),
+                  capacity(capacity),
+                  elements(static_cast<pointer>(::operator new(capacity * sizeof(Type))))
+            {}
+
+            ~Buffer()
+            {
+                for (size_type i = 0; i < size; i++)
+                    elements[i].~Type();
+
+                ::operator delete(elements);
+            }
+        };
+
+        // nullptr until the first append, and after being moved from.
+        Buffer *buffer;
+
+    public:
+        SharedVector()
+            : buffer(nullptr)
+        {}
+
+        SharedVector(std::initializer_list<Type> l)
+            : buffer(new Buffer(l.size()))
+        {
+            for (auto& el : l)
+                append(el);
+        }
+
+        SharedVector(const SharedVector &other)
+            : buffer(other.buffer)
+        {
+            share();
+        }
+
+        SharedVector(SharedVector &&other) noexcept
+            : buffer(other.buffer)
+        {
+            other.buffer = nullptr;
+        }
+
+        ~SharedVector()
+        {
+            release();
+        }
+
+        SharedVector &operator=(const SharedVector &other)
+        {
+            if (buffer == other.buffer)
+                return *this;
+
+            release();
+            buffer = other.buffer;
+            share();
+
+            return *this;
+        }
+
+        SharedVector &operator=(SharedVector &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            release();
+            buffer = other.buffer;
+            other.buffer = nullptr;
+
+            return *this;
+        }
+
+        bool isEmpty() const
+        {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const
+        {
+            return buffer != nullptr ? buffer->size : 0;
+        }
+
+        size_type getCapacity() const
+        {
+            return buffer != nullptr ? buffer->capacity : 0;
+        }
+
+        // Whether another handle uses the same buffer, so that the next
+        // modification will clone it.
+        bool isShared() const
+        {
+            return buffer != nullptr && buffer->references.load(std::memory_order_acquire) > 1;
+        }
+
+        reference operator[](size_type index)
+        {
+            detach();
+            return buffer->elements[index];
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return buffer->elements[index];
+        }
+
+        void append(const Type &item)
+        {
+            insertAt(getSize(), item);
+        }
+
+        void prepend(const Type &item)
+        {
+            insertAt(0, item);
+        }
+
+        void insert(const const_iterator &insertPosition, const Type &item)
+        {
+            insertAt(insertPosition.getIndex(), item);
+        }
+
+        Type popFirst()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popFirst when collection is empty");
+            detach();
+
+            Type value = std::move(buffer->elements[0]);
+            eraseRange(0, 1);
+            return value;
+        }
+
+        Type popLast()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popLast when collection is empty");
+            detach();
+
+            Type value = std::move(buffer->elements[buffer->size - 1]);
+            eraseRange(buffer->size - 1, 1);
+            return value;
+        }
+
+        void erase(const const_iterator &position)
+        {
+            throwIfCollectionEmpty<std::out_of_range>(
+                    "cannot erase from empty collection");
+
+            throwIfIteratorEqualsEnd<std::out_of_range>(
+                    position,
+                    "cannot erase end");
+            detach();
+
+            eraseRange(position.getIndex(), 1);
+        }
+
+        void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+        {
+            if (firstIncluded == lastExcluded)
+                return;
+
+            detach();
+            eraseRange(firstIncluded.getIndex(), lastExcluded.getIndex() - firstIncluded.getIndex());
+        }
+
+        iterator begin()
+        {
+            detach();
+            return Iterator(this, 0);
+        }
+
+        iterator end()
+        {
+            detach();
+            return Iterator(this, getSize());
+        }
+
+        const_iterator cbegin() const
+        {
+            return ConstIterator(this, 0);
+        }
+
+        const_iterator cend() const
+        {
+            return ConstIterator(this, getSize());
+        }
+
+        const_iterator begin() const
+        {
+            return cbegin();
+        }
+
+        const_iterator end() const
+        {
+            return cend();
+        }
+
+    private:
+        void share()
+        {
+            if (buffer != nullptr)
+                buffer->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // The last handle to let go frees the buffer; acq_rel makes the
+        // other handles' writes to it happen before the destruction.
+        void release()
+        {
+            if (buffer != nullptr && buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete buffer;
+
+            buffer = nullptr;
+        }
+
+        void detach()
+        {
+            if (isShared())
+                reallocate(buffer->capacity);
+        }
+
+        // Makes the buffer this handle's own, with room for required
+        // elements.
+        void prepareForWrite(size_type required)
+        {
+            if (buffer == nullptr)
+                buffer = new Buffer(required > DEFAULT_INITIAL_CAPACITY ? required : DEFAULT_INITIAL_CAPACITY);
+            else if (buffer->capacity < required)
+                reallocate(buffer->capacity * 2 < required ? required : buffer->capacity * 2);
+            else
+                detach();
+        }
+
+        // Moves the elements out of a buffer nobody else holds, copies them
+        // out of a shared one.
+        void reallocate(size_type capacity)
+        {
+            Buffer *fresh = new Buffer(capacity);
+            const bool shared = isShared();
+
+            for (; fresh->size < buffer->size; fresh->size++)
+            {
+                if (shared)
+                    new (&fresh->elements[fresh->size]) Type(buffer->elements[fresh->size]);
+                else
+                    new (&fresh->elements[fresh->size]) Type(std::move(buffer->elements[fresh->size]));
+            }
+
+            release();
+            buffer = fresh;
+        }
+
+        void insertAt(size_type index, const Type &item)
+        {
+            prepareForWrite(getSize() + 1);
+            pointer elements = buffer->elements;
+            size_type size = buffer->size;
+
+            if (index == size)
+            {
+                new (&elements[size]) Type(item);
+            }
+            else
+            {
+                new (&elements[size]) Type(std::move(elements[size - 1]));
+                std::move_backward(elements + index, elements + size - 1, elements + size);
+                elements[index] = item;
+            }
+
+            buffer->size++;
+        }
+
+        void eraseRange(size_type first, size_type count)
+        {
+            pointer elements = buffer->elements;
+            size_type size = buffer->size;
+
+            std::move(elements + first + count, elements + size, elements + first);
+            for (size_type i = size - count; i < size; i++)
+                elements[i].~Type();
+
+            buffer->size -= count;
+        }
+
+        template <typename Exception>
+        void throwIfCollectionEmpty(const char *message) const
+        {
+            if (isEmpty())
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfIteratorEqualsEnd(const ConstIterator &iterator, const char *message) const
+        {
+            if (iterator.getIndex() >= getSize())
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    class SharedVector<Type>::ConstIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename SharedVector::value_type;
+        using difference_type = typename SharedVector::difference_type;
+        using pointer = typename SharedVector::const_pointer;
+        using reference = typename SharedVector::const_reference;
+        using size_type = typename SharedVector::size_type;
+
+        friend class SharedVector;
+
+    private:
+        const SharedVector *collection;
+        size_type index;
+
+    public:
+        explicit ConstIterator(const SharedVector *collection, size_type index)
+            : collection(collection),
+              index(index)
+        {}
+
+        ConstIterator()
+            : collection(nullptr),
+              index(0)
+        {}
+
+        reference operator*() const
+        {
+            throwIfEnd<std::out_of_range>(
+                    "end iterator cannot be dereferenced");
+
+            return (*collection)[index];
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+
+        ConstIterator &operator++()
+        {
+            throwIfEnd<std::out_of_range>(
+                    "cannot increment end iterator");
+
+            index++;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator old = *this;
+            operator++();
+            return old;
+        }
+
+        ConstIterator &operator--()
+        {
+            throwIfBegin<std::out_of_range>(
+                    "cannot decrement begin iterator");
+
+            index--;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator old = *this;
+            operator--();
+            return old;
+        }
+
+        ConstIterator &operator+=(difference_type d)
+        {
+            index += d;
+            return *this;
+        }
+
+        ConstIterator &operator-=(difference_type d)
+        {
+            index -= d;
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type d) const
+        {
+            return ConstIterator(collection, index + d);
+        }
+
+        ConstIterator operator-(difference_type d) const
+        {
+            return ConstIterator(collection, index - d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const ConstIterator &other) const
+        {
+            return collection == other.collection && index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const
+        {
+            return !operator==(other);
+        }
+
+        bool operator<(const ConstIterator &other) const
+        {
+            return index < other.index;
+        }
+
+        bool operator>(const ConstIterator &other) const
+        {
+            return other < *this;
+        }
+
+        bool operator<=(const ConstIterator &other) const
+        {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ConstIterator &other) const
+        {
+            return !(*this < other);
+        }
+
+    protected:
+        size_type getIndex() const
+        {
+            return index;
+        }
+
+        template <typename Exception>
+        void throwIfBegin(const char *message) const
+        {
+            if (index == 0)
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfEnd(const char *message) const
+        {
+            if (index >= collection->getSize())
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    class SharedVector<Type>::Iterator : public SharedVector<Type>::ConstIterator
+    {
+    public:
+        using pointer = typename SharedVector::pointer;
+        using reference = typename SharedVector::reference;
+        using size_type = typename SharedVector::size_type;
+
+        explicit Iterator(SharedVector *collection, size_type index)
+            : ConstIterator(collection, index)
+        {}
+
+        Iterator()
+        {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other)
+        {}
+
+        Iterator &operator++()
+        {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--()
+        {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator &operator+=(difference_type d)
+        {
+            ConstIterator::operator+=(d);
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type d)
+        {
+            ConstIterator::operator-=(d);
+            return *this;
+        }
+
+        Iterator operator+(difference_type d) const
+        {
+            return ConstIterator::operator+(d);
+        }
+
+        Iterator operator-(difference_type d) const
+        {
+            return ConstIterator::operator-(d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return ConstIterator::operator-(other);
+        }
+
+        reference operator*() const
+        {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_SHAREDVECTOR_H
@@ -0,0 +1,852 @@
+#ifndef AISDI_LINEAR_TIEREDVECTOR_H
+#define AISDI_LINEAR_TIEREDVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace aisdi
+{
+
+    // Tiered vector (Goodrich & Kloss): a circular array of tiers, each tier a
+    // circular buffer of tierCapacity slots. Every tier except the first and
+    // the last is full, so an index maps to its tier with one shift and one
+    // mask. Inserting or erasing shifts elements inside a single tier and then
+    // passes one element per tier towards the back, which costs
+    // O(tierCapacity + tierCount). tierCapacity is kept near sqrt(size), so
+    // both terms are O(sqrt n).
+    template<typename Type>
+    class TieredVector
+    {
+    public:
+        class ConstIterator;
+        class Iterator;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type *;
+        using reference = Type &;
+        using const_pointer = const Type *;
+        using const_reference = const Type &;
+
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+    private:
+        struct Tier
+        {
+            pointer slots;
+            size_type head;
+            size_type count;
+        };
+
+        static const size_type MIN_TIER_SHIFT = 4;
+        static const size_type MIN_TOP_CAPACITY = 4;
+
+        Tier *tiers;
+        size_type topCapacity;
+        size_type topHead;
+        size_type tierCount;
+        size_type tierShift;
+        size_type size;
+
+    public:
+        explicit TieredVector()
+            : tiers(nullptr),
+              topCapacity(0),
+              topHead(0),
+              tierCount(0),
+              tierShift(MIN_TIER_SHIFT),
+              size(0)
+        {}
+
+        TieredVector(std::initializer_list<Type> l)
+            : TieredVector()
+        {
+            copyFrom(l);
+        }
+
+        TieredVector(const TieredVector &other)
+            : TieredVector()
+        {
+            copyFrom(other);
+        }
+
+        TieredVector(TieredVector &&other) noexcept
+            : TieredVector()
+        {
+            moveFrom(other);
+        }
+
+        ~TieredVector()
+        {
+            destroyElements();
+            delete [] tiers;
+        }
+
+        TieredVector &operator=(const TieredVector &other)
+        {
+            if (this == &other)
+                return *this;
+
+            destroyElements();
+            copyFrom(other);
+
+            return *this;
+        }
+
+        TieredVector &operator=(TieredVector &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            destroyElements();
+            moveFrom(other);
+
+            return *this;
+        }
+
+        bool isEmpty() const
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const
+        {
+            return size;
+        }
+
+        size_type getTierCapacity() const
+        {
+            return size_type(1) << tierShift;
+        }
+
+        reference operator[](size_type index)
+        {
+            return *slotAt(index);
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return *slotAt(index);
+        }
+
+        void append(const Type &item)
+        {
+            if (tierCount == 0 || isFull(lastTier()))
+                addTierAtBack();
+
+            pushBack(lastTier(), item);
+            size++;
+
+            retierIfNeeded();
+        }
+
+        void prepend(const Type &item)
+        {
+            if (tierCount == 0 || isFull(firstTier()))
+                addTierAtFront();
+
+            pushFront(firstTier(), item);
+            size++;
+
+            retierIfNeeded();
+        }
+
+        void insert(const const_iterator &insertPosition, const Type &item)
+        {
+            insertAt(insertPosition.getIndex(), item);
+        }
+
+        void insertAt(size_type index, const Type &item)
+        {
+            if (index == size)
+                return append(item);
+
+            if (index == 0)
+                return prepend(item);
+
+            size_type tierIndex, position;
+            locate(index, tierIndex, position);
+
+            Tier &tier = tierAt(tierIndex);
+            if (!isFull(tier))
+            {
+                insertIntoTier(tier, position, item);
+            }
+            else
+            {
+                Type carried = popBack(tier);
+                insertIntoTier(tier, position, item);
+                carryTowardsBack(tierIndex + 1, std::move(carried));
+            }
+
+            size++;
+
+            retierIfNeeded();
+        }
+
+        Type popFirst()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popFirst when collection is empty");
+
+            Type value = popFront(firstTier());
+            size--;
+            dropEmptyEdgeTiers();
+            retierIfNeeded();
+
+            return value;
+        }
+
+        Type popLast()
+        {
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popLast when collection is empty");
+
+            Type value = popBack(lastTier());
+            size--;
+            dropEmptyEdgeTiers();
+            retierIfNeeded();
+
+            return value;
+        }
+
+        void erase(const const_iterator &position)
+        {
+            throwIfCollectionEmpty<std::out_of_range>(
+                    "cannot erase from empty collection");
+
+            throwIfIteratorEqualsEnd<std::out_of_range>(
+                    position,
+                    "cannot erase end");
+
+            eraseAt(position.getIndex());
+        }
+
+        void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+        {
+            if (firstIncluded == lastExcluded)
+                return;
+
+            size_type first = firstIncluded.getIndex();
+            size_type last = lastExcluded.getIndex();
+            size_type count = last - first;
+
+            for (size_type i = last; i < size; i++)
+                *slotAt(i - count) = std::move(*slotAt(i));
+
+            for (size_type i = 0; i < count; i++)
+            {
+                discardBack(lastTier());
+                size--;
+                dropEmptyEdgeTiers();
+            }
+
+            retierIfNeeded();
+        }
+
+        iterator begin()
+        {
+            return Iterator(this, 0);
+        }
+
+        iterator end()
+        {
+            return Iterator(this, size);
+        }
+
+        const_iterator cbegin() const
+        {
+            return ConstIterator(this, 0);
+        }
+
+        const_iterator cend() const
+        {
+            return ConstIterator(this, size);
+        }
+
+        const_iterator begin() const
+        {
+            return cbegin();
+        }
+
+        const_iterator end() const
+        {
+            return cend();
+        }
+
+    private:
+        size_type tierMask() const
+        {
+            return getTierCapacity() - 1;
+        }
+
+        Tier &tierAt(size_type tierIndex) const
+        {
+            return tiers[(topHead + tierIndex) & (topCapacity - 1)];
+        }
+
+        Tier &firstTier() const
+        {
+            return tierAt(0);
+        }
+
+        Tier &lastTier() const
+        {
+            return tierAt(tierCount - 1);
+        }
+
+        bool isFull(const Tier &tier) const
+        {
+            return tier.count == getTierCapacity();
+        }
+
+        pointer slotIn(const Tier &tier, size_type position) const
+        {
+            return tier.slots + ((tier.head + position) & tierMask());
+        }
+
+        void locate(size_type index, size_type &tierIndex, size_type &position) const
+        {
+            size_type firstCount = firstTier().count;
+
+            if (index < firstCount)
+            {
+                tierIndex = 0;
+                position = index;
+                return;
+            }
+
+            index -= firstCount;
+            tierIndex = 1 + (index >> tierShift);
+            position = index & tierMask();
+        }
+
+        pointer slotAt(size_type index) const
+        {
+            size_type tierIndex, position;
+            locate(index, tierIndex, position);
+            return slotIn(tierAt(tierIndex), position);
+        }
+
+        template<typename Value>
+        void pushBack(Tier &tier, Value &&item)
+        {
+            new (slotIn(tier, tier.count)) Type(std::forward<Value>(item));
+            tier.count++;
+        }
+
+        template<typename Value>
+        void pushFront(Tier &tier, Value &&item)
+        {
+            size_type newHead = (tier.head - 1) & tierMask();
+            new (tier.slots + newHead) Type(std::forward<Value>(item));
+            tier.head = newHead;
+            tier.count++;
+        }
+
+        Type popBack(Tier &tier)
+        {
+            pointer slot = slotIn(tier, tier.count - 1);
+            Type value = std::move(*slot);
+            slot->~Type();
+            tier.count--;
+            return value;
+        }
+
+        Type popFront(Tier &tier)
+        {
+            pointer slot = slotIn(tier, 0);
+            Type value = std::move(*slot);
+            slot->~Type();
+            tier.head = (tier.head + 1) & tierMask();
+            tier.count--;
+            return value;
+        }
+
+        void discardBack(Tier &tier)
+        {
+            slotIn(tier, tier.count - 1)->~Type();
+            tier.count--;
+        }
+
+        void discardFront(Tier &tier)
+        {
+            slotIn(tier, 0)->~Type();
+            tier.head = (tier.head + 1) & tierMask();
+            tier.count--;
+        }
+
+        // Tier must have a free slot. Shifts the shorter side of position.
+        void insertIntoTier(Tier &tier, size_type position, const Type &item)
+        {
+            if (position < tier.count / 2)
+            {
+                if (position == 0)
+                    return pushFront(tier, item);
+
+                pushFront(tier, std::move(*slotIn(tier, 0)));
+                for (size_type i = 1; i < position; i++)
+                    *slotIn(tier, i) = std::move(*slotIn(tier, i + 1));
+            }
+            else
+            {
+                if (position == tier.count)
+                    return pushBack(tier, item);
+
+                pushBack(tier, std::move(*slotIn(tier, tier.count - 1)));
+                for (size_type i = tier.count - 2; i > position; i--)
+                    *slotIn(tier, i) = std::move(*slotIn(tier, i - 1));
+            }
+
+            *slotIn(tier, position) = item;
+        }
+
+        void eraseFromTier(Tier &tier, size_type position)
+        {
+            if (position < tier.count / 2)
+            {
+                for (size_type i = position; i > 0; i--)
+                    *slotIn(tier, i) = std::move(*slotIn(tier, i - 1));
+
+                discardFront(tier);
+            }
+            else
+            {
+                for (size_type i = position; i + 1 < tier.count; i++)
+                    *slotIn(tier, i) = std::move(*slotIn(tier, i + 1));
+
+                discardBack(tier);
+            }
+        }
+
+        // Pushes carried into the front of tierIndex, passing each displaced
+        // last element on to the next tier.
+        void carryTowardsBack(size_type tierIndex, Type &&carried)
+        {
+            for (; tierIndex < tierCount; tierIndex++)
+            {
+                Tier &tier = tierAt(tierIndex);
+
+                if (!isFull(tier))
+                    return pushFront(tier, std::move(carried));
+
+                Type next = popBack(tier);
+                pushFront(tier, std::move(carried));
+                carried = std::move(next);
+            }
+
+            addTierAtBack();
+            pushBack(lastTier(), std::move(carried));
+        }
+
+        void eraseAt(size_type index)
+        {
+            size_type tierIndex, position;
+            locate(index, tierIndex, position);
+
+            eraseFromTier(tierAt(tierIndex), position);
+
+            if (tierIndex > 0)
+            {
+                for (size_type i = tierIndex + 1; i < tierCount; i++)
+                    pushBack(tierAt(i - 1), popFront(tierAt(i)));
+            }
+
+            size--;
+            dropEmptyEdgeTiers();
+            retierIfNeeded();
+        }
+
+        void dropEmptyEdgeTiers()
+        {
+            if (tierCount > 0 && lastTier().count == 0)
+            {
+                freeTier(lastTier());
+                tierCount--;
+            }
+
+            if (tierCount > 0 && firstTier().count == 0)
+            {
+                freeTier(firstTier());
+                topHead = (topHead + 1) & (topCapacity - 1);
+                tierCount--;
+            }
+        }
+
+        void addTierAtBack()
+        {
+            if (tierCount == topCapacity)
+                growTop();
+
+            tierCount++;
+            allocateTier(lastTier());
+        }
+
+        void addTierAtFront()
+        {
+            if (tierCount == topCapacity)
+                growTop();
+
+            topHead = (topHead - 1) & (topCapacity - 1);
+            tierCount++;
+            allocateTier(firstTier());
+        }
+
+        void growTop()
+        {
+            size_type newCapacity = topCapacity == 0 ? MIN_TOP_CAPACITY : topCapacity * 2;
+            Tier *newTiers = new Tier[newCapacity];
+
+            for (size_type i = 0; i < tierCount; i++)
+                newTiers[i] = tierAt(i);
+
+            delete [] tiers;
+
+            tiers = newTiers;
+            topCapacity = newCapacity;
+            topHead = 0;
+        }
+
+        void allocateTier(Tier &tier)
+        {
+            tier.slots = static_cast<pointer>(::operator new(getTierCapacity() * sizeof(Type)));
+            tier.head = 0;
+            tier.count = 0;
+        }
+
+        void freeTier(Tier &tier)
+        {
+            ::operator delete(tier.slots);
+            tier.slots = nullptr;
+        }
+
+        // Keeps tierCapacity within a factor of two of sqrt(size).
+        void retierIfNeeded()
+        {
+            size_type capacity = getTierCapacity();
+
+            if (size > 4 * capacity * capacity)
+                retier(tierShift + 1);
+            else if (tierShift > MIN_TIER_SHIFT && 4 * size < capacity * capacity)
+                retier(tierShift - 1);
+        }
+
+        void retier(size_type newTierShift)
+        {
+            TieredVector retiered;
+            retiered.tierShift = newTierShift;
+
+            for (size_type i = 0; i < tierCount; i++)
+            {
+                Tier &tier = tierAt(i);
+                while (tier.count > 0)
+                {
+                    if (retiered.tierCount == 0 || retiered.isFull(retiered.lastTier()))
+                        retiered.addTierAtBack();
+
+                    retiered.pushBack(retiered.lastTier(), popFront(tier));
+                }
+                freeTier(tier);
+            }
+
+            retiered.size = size;
+            tierCount = 0;
+            size = 0;
+            delete [] tiers;
+            tiers = nullptr;
+            topCapacity = 0;
+
+            moveFrom(retiered);
+        }
+
+        void destroyElements()
+        {
+            for (size_type i = 0; i < tierCount; i++)
+            {
+                Tier &tier = tierAt(i);
+                for (size_type j = 0; j < tier.count; j++)
+                    slotIn(tier, j)->~Type();
+                freeTier(tier);
+            }
+
+            tierCount = 0;
+            size = 0;
+            tierShift = MIN_TIER_SHIFT;
+        }
+
+        template<class Collection>
+        void copyFrom(const Collection &collection)
+        {
+            for (auto& el : collection)
+                append(el);
+        }
+
+        void moveFrom(TieredVector &other)
+        {
+            std::swap(tiers, other.tiers);
+            std::swap(topCapacity, other.topCapacity);
+            std::swap(topHead, other.topHead);
+            std::swap(tierCount, other.tierCount);
+            std::swap(tierShift, other.tierShift);
+            std::swap(size, other.size);
+        }
+
+        template <typename Exception>
+        void throwIfCollectionEmpty(const char *message) const
+        {
+            if (isEmpty())
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfIteratorEqualsEnd(const ConstIterator &iterator, const char *message) const
+        {
+            if (iterator.getIndex() >= size)
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    class TieredVector<Type>::ConstIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename TieredVector::value_type;
+        using difference_type = typename TieredVector::difference_type;
+        using pointer = typename TieredVector::const_pointer;
+        using reference = typename TieredVector::const_reference;
+        using size_type = typename TieredVector::size_type;
+
+        friend class TieredVector;
+
+    private:
+        const TieredVector *collection;
+        size_type index;
+
+    public:
+        explicit ConstIterator(const TieredVector *collection, size_type index)
+            : collection(collection),
+              index(index)
+        {}
+
+        ConstIterator()
+            : collection(nullptr),
+              index(0)
+        {}
+
+        reference operator*() const
+        {
+            throwIfEnd<std::out_of_range>(
+                    "end iterator cannot be dereferenced");
+
+            return *collection->slotAt(index);
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+
+        ConstIterator &operator++()
+        {
+            throwIfEnd<std::out_of_range>(
+                    "cannot increment end iterator");
+
+            index++;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator old = *this;
+            operator++();
+            return old;
+        }
+
+        ConstIterator &operator--()
+        {
+            throwIfBegin<std::out_of_range>(
+                    "cannot decrement begin iterator");
+
+            index--;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator old = *this;
+            operator--();
+            return old;
+        }
+
+        ConstIterator &operator+=(difference_type d)
+        {
+            index += d;
+            return *this;
+        }
+
+        ConstIterator &operator-=(difference_type d)
+        {
+            index -= d;
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type d) const
+        {
+            return ConstIterator(collection, index + d);
+        }
+
+        ConstIterator operator-(difference_type d) const
+        {
+            return ConstIterator(collection, index - d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const ConstIterator &other) const
+        {
+            return collection == other.collection && index == other.index;
+        }
+
+        bool operator!=(const ConstIterator &other) const
+        {
+            return !operator==(other);
+        }
+
+        bool operator<(const ConstIterator &other) const
+        {
+            return index < other.index;
+        }
+
+        bool operator>(const ConstIterator &other) const
+        {
+            return other < *this;
+        }
+
+        bool operator<=(const ConstIterator &other) const
+        {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ConstIterator &other) const
+        {
+            return !(*this < other);
+        }
+
+    protected:
+        size_type getIndex() const
+        {
+            return index;
+        }
+
+        template <typename Exception>
+        void throwIfBegin(const char *message) const
+        {
+            if (index == 0)
+                throw Exception(message);
+        }
+
+        template <typename Exception>
+        void throwIfEnd(const char *message) const
+        {
+            if (index >= collection->getSize())
+                throw Exception(message);
+        }
+    };
+
+    template<typename Type>
+    class TieredVector<Type>::Iterator : public TieredVector<Type>::ConstIterator
+    {
+    public:
+        using pointer = typename TieredVector::pointer;
+        using reference = typename TieredVector::reference;
+        using size_type = typename TieredVector::size_type;
+
+        explicit Iterator(TieredVector *collection, size_type index)
+            : ConstIterator(collection, index)
+        {}
+
+        Iterator()
+        {}
+
+        Iterator(const ConstIterator &other)
+                : ConstIterator(other)
+        {}
+
+        Iterator &operator++()
+        {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator &operator--()
+        {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator &operator+=(difference_type d)
+        {
+            ConstIterator::operator+=(d);
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type d)
+        {
+            ConstIterator::operator-=(d);
+            return *this;
+        }
+
+        Iterator operator+(difference_type d) const
+        {
+            return ConstIterator::operator+(d);
+        }
+
+        Iterator operator-(difference_type d) const
+        {
+            return ConstIterator::operator-(d);
+        }
+
+        difference_type operator-(const ConstIterator &other) const
+        {
+            return ConstIterator::operator-(other);
+        }
+
+        reference operator*() const
+        {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+
+        reference operator[](difference_type d) const
+        {
+            return *(*this + d);
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_TIEREDVECTOR_H
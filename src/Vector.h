@@ -29,10 +29,19 @@ namespace aisdi
 
     private:
         static const size_type DEFAULT_INITIAL_CAPACITY = 30;
+        // Elements copied out of the retired buffer by every append.
+        static const size_type GROWTH_STEP = 2;
         pointer elements = nullptr;
         size_type size;
         size_type capacity;
         mutable const_iterator pastTheEnd = nullptr;
+        bool incrementalGrowth = false;
+        // While growing incrementally, elements [migrated, retiredSize) are
+        // still in the retired buffer. Const access completes the growth,
+        // hence mutable, and hence not thread-safe while growing.
+        mutable pointer retired = nullptr;
+        mutable size_type retiredSize = 0;
+        mutable size_type migrated = 0;
 
     public:
         explicit Vector(size_type initialCapacity = DEFAULT_INITIAL_CAPACITY)
@@ -51,6 +60,7 @@ namespace aisdi
         Vector(const Vector &other)
             : Vector(other.getCapacity())
         {
+            incrementalGrowth = other.incrementalGrowth;
             copyFromAndAppend(other);
         }
 
@@ -70,6 +80,8 @@ namespace aisdi
             if (this == &other)
                 return *this;
 
+            completeGrowth();
+
             if (capacity < other.getSize())
                 reallocateMemory(other.getSize());
 
@@ -80,8 +92,7 @@ namespace aisdi
 
         Vector &operator=(Vector &&other) noexcept
         {
-            if (elements != nullptr)
-                delete [] elements;
+            freeMemoryIfAllocated();
 
             moveFrom(other);
 
@@ -103,8 +114,41 @@ namespace aisdi
             return capacity;
         }
 
+        // With incremental growth, a full Vector does not copy its elements
+        // at once: it allocates the doubled buffer and every later append
+        // copies GROWTH_STEP of them, so no single append costs O(n). Any
+        // other access to the elements completes the copying first.
+        //
+        // That includes const begin() and end(), which then copy elements
+        // and free the retired buffer. While incremental growth is on,
+        // const access is therefore not safe to share across threads: a
+        // Vector read by several threads at once must not have it enabled,
+        // or must be brought up to date first, e.g. by
+        // disableIncrementalGrowth().
+        void enableIncrementalGrowth()
+        {
+            incrementalGrowth = true;
+        }
+
+        void disableIncrementalGrowth()
+        {
+            completeGrowth();
+            incrementalGrowth = false;
+        }
+
+        bool hasIncrementalGrowth() const
+        {
+            return incrementalGrowth;
+        }
+
         void append(const Type &item)
         {
+            if (incrementalGrowth)
+            {
+                appendIncrementally(item);
+                return;
+            }
+
             reallocateMemoryIfNeeded();
             elements[size] = item;
             size++;
@@ -112,6 +156,7 @@ namespace aisdi
 
         void prepend(const Type &item)
         {
+            completeGrowth();
             reallocateMemoryIfNeeded();
             shiftElementsToRightFrom(0);
             elements[0] = item;
@@ -120,6 +165,7 @@ namespace aisdi
 
         void insert(const const_iterator &insertPosition, const Type &item)
         {
+            completeGrowth();
             //NOTE: index needs to be calculated before reallocation!
             size_type insertIndex = insertPosition.calculateIndex();
             reallocateMemoryIfNeeded();
@@ -130,8 +176,9 @@ namespace aisdi
 
         Type popFirst()
         {
-            throwIfCollectionEmpty(
-                    std::logic_error("cannot popFirst when collection is empty"));
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popFirst when collection is empty");
+            completeGrowth();
 
             value_type value = elements[0];
             shiftElementsToLeftUpTo(0);
@@ -141,8 +188,9 @@ namespace aisdi
 
         Type popLast()
         {
-            throwIfCollectionEmpty(
-                    std::logic_error("cannot popLast when collection is empty"));
+            throwIfCollectionEmpty<std::logic_error>(
+                    "cannot popLast when collection is empty");
+            completeGrowth();
 
             value_type value = elements[size-1];
             size--;
@@ -151,12 +199,13 @@ namespace aisdi
 
         void erase(const const_iterator &position)
         {
-            throwIfCollectionEmpty(
-                    std::out_of_range("cannot erase from empty collection"));
+            throwIfCollectionEmpty<std::out_of_range>(
+                    "cannot erase from empty collection");
 
-            throwIfIteratorEqaulsEnd(
+            throwIfIteratorEqaulsEnd<std::out_of_range>(
                     position,
-                    std::out_of_range("cannot erase end"));
+                    "cannot erase end");
+            completeGrowth();
 
             shiftElementsToLeftUpTo(position.calculateIndex());
             size--;
@@ -167,6 +216,8 @@ namespace aisdi
             if (firstIncluded == lastExcluded)
                 return;
 
+            completeGrowth();
+
             size_type firstIncludeIndex = firstIncluded.calculateIndex();
             size_type lastExcludedIndex = lastExcluded.calculateIndex();
 
@@ -230,6 +281,8 @@ namespace aisdi
 
         void moveFrom(Vector& other)
         {
+            other.completeGrowth();
+            incrementalGrowth = other.incrementalGrowth;
             elements = other.elements;
             size = other.getSize();
             capacity = other.getCapacity();
@@ -241,6 +294,52 @@ namespace aisdi
         {
             if (elements != nullptr)
                 delete [] elements;
+
+            delete [] retired;
+            retired = nullptr;
+        }
+
+        void appendIncrementally(const Type &item)
+        {
+            if (size + 1 > capacity)
+            {
+                completeGrowth();
+                pointer grown = new Type[capacity * 2];
+                retired = elements;
+                retiredSize = size;
+                migrated = 0;
+                capacity *= 2;
+                elements = grown;
+            }
+
+            elements[size] = item;
+            size++;
+
+            if (retired != nullptr)
+                migrate(GROWTH_STEP);
+        }
+
+        // The doubled capacity leaves retiredSize appends until the next
+        // growth, so with GROWTH_STEP >= 1 an append-only workload never
+        // needs to complete a growth at once.
+        void migrate(size_type count) const
+        {
+            size_type last = migrated + count < retiredSize ? migrated + count : retiredSize;
+
+            for (; migrated < last; migrated++)
+                elements[migrated] = retired[migrated];
+
+            if (migrated == retiredSize)
+            {
+                delete [] retired;
+                retired = nullptr;
+            }
+        }
+
+        void completeGrowth() const
+        {
+            if (retired != nullptr)
+                migrate(retiredSize - migrated);
         }
 
         void reallocateMemoryIfNeeded()
@@ -287,17 +386,20 @@ namespace aisdi
 
         const_iterator& preparePastTheEnd() const
         {
+            completeGrowth();
             pastTheEnd.currentElement = &elements[size];
             return pastTheEnd;
         }
 
         iterator createBegin()
         {
+            completeGrowth();
             return Iterator(&elements[0], this, ConstIterator::IteratorType::BEGIN);
         }
 
         const_iterator createConstBegin() const
         {
+            completeGrowth();
             return ConstIterator(&elements[0], this, ConstIterator::IteratorType::BEGIN);
         }
 
@@ -316,17 +418,17 @@ namespace aisdi
         }
 
         template <typename Exception>
-        void throwIfCollectionEmpty(const Exception& e)
+        void throwIfCollectionEmpty(const char *message)
         {
             if (isEmpty())
-                throw e;
+                throw Exception(message);
         }
 
         template <typename Exception>
-        void throwIfIteratorEqaulsEnd(const ConstIterator &iterator, const Exception &e)
+        void throwIfIteratorEqaulsEnd(const ConstIterator &iterator, const char *message)
         {
             if (iterator.isEnd())
-                throw e;
+                throw Exception(message);
         }
     };
 
@@ -364,16 +466,16 @@ namespace aisdi
 
         reference operator*() const
         {
-            throwIfEnd(
-                    std::out_of_range("end iterator cannot be dereferenced"));
+            throwIfEnd<std::out_of_range>(
+                    "end iterator cannot be dereferenced");
 
             return *currentElement;
         }
 
         ConstIterator &operator++()
         {
-            throwIfEnd(
-                    std::out_of_range("cannot increment end iterator"));
+            throwIfEnd<std::out_of_range>(
+                    "cannot increment end iterator");
 
             currentElement++;
 
@@ -395,8 +497,8 @@ namespace aisdi
 
         ConstIterator &operator--()
         {
-            throwIfBegin(
-                    std::out_of_range("cannot decrement begin iterator"));
+            throwIfBegin<std::out_of_range>(
+                    "cannot decrement begin iterator");
 
             currentElement--;
 
@@ -476,17 +578,17 @@ namespace aisdi
         }
 
         template <typename Exception>
-        void throwIfBegin(const Exception& e) const
+        void throwIfBegin(const char *message) const
         {
             if (isBegin())
-                throw e;
+                throw Exception(message);
         }
 
         template <typename Exception>
-        void throwIfEnd(const Exception& e) const
+        void throwIfEnd(const char *message) const
         {
             if (isEnd())
-                throw e;
+                throw Exception(message);
         }
     };
 
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "Benchmark.h"
+#include "BenchmarkResults.h"
+
+using namespace aisdi;
+
+namespace
+{
+
+    using RecordKey = std::tuple<std::string, std::string, std::string, std::size_t>;
+
+    RecordKey keyOf(const BenchmarkRecord &record)
+    {
+        return RecordKey(record.operation, record.container, record.type, record.size);
+    }
+
+    BenchmarkResults load(const char *path)
+    {
+        std::ifstream in(path);
+        if (!in)
+            throw std::runtime_error(std::string("cannot open ") + path);
+        return BenchmarkResults::read(in);
+    }
+
+    struct Comparison
+    {
+        double change;      // relative change of the median time per operation
+        double t;           // Welch's t statistic of the mean time per operation
+        double critical;    // two-sided 95% critical value for t
+    };
+
+    // Welch's t-test on mean time per operation, so that results taken
+    // with different batch sizes remain comparable.
+    Comparison compare(const BenchmarkStatistics &baseline, const BenchmarkStatistics &current)
+    {
+        const double baselineScale = baseline.operationsPerRun > 0 ? 1.0 / baseline.operationsPerRun : 0;
+        const double currentScale = current.operationsPerRun > 0 ? 1.0 / current.operationsPerRun : 0;
+
+        const double baselineVariance = std::pow(baseline.stddev * baselineScale, 2) / std::max<std::size_t>(1, baseline.runs);
+        const double currentVariance = std::pow(current.stddev * currentScale, 2) / std::max<std::size_t>(1, current.runs);
+        const double standardError = std::sqrt(baselineVariance + currentVariance);
+        const double difference = current.mean * currentScale - baseline.mean * baselineScale;
+
+        Comparison comparison;
+        comparison.change = baseline.nanosecondsPerOperation() > 0
+                            ? current.nanosecondsPerOperation() / baseline.nanosecondsPerOperation() - 1 : 0;
+
+        if (standardError == 0)
+        {
+            comparison.t = difference == 0 ? 0 : (difference > 0 ? HUGE_VAL : -HUGE_VAL);
+            comparison.critical = 0;
+            return comparison;
+        }
+
+        // Welch-Satterthwaite degrees of freedom.
+        const double denominator =
+                (baseline.runs > 1 ? baselineVariance * baselineVariance / (baseline.runs - 1) : 0)
+                + (current.runs > 1 ? currentVariance * currentVariance / (current.runs - 1) : 0);
+        const double degreesOfFreedom = denominator > 0
+                                        ? std::pow(baselineVariance + currentVariance, 2) / denominator : 1;
+
+        comparison.t = difference / standardError;
+        comparison.critical = Benchmark::studentT95(degreesOfFreedom);
+        return comparison;
+    }
+
+    void printMetadata(const char *label, const BenchmarkMetadata &metadata)
+    {
+        std::cout << label << ": " << metadata.gitSha << " on " << metadata.host
+                  << ", " << metadata.compiler << ", flags: " << metadata.flags << '\n';
+    }
+
+}
+
+// Usage: aisdiCompare baseline current [threshold]
+// Compares two result files written by aisdiLinear --format=json|csv and
+// lists every row whose time per operation changed significantly (Welch's
+// t-test at 95%) by more than threshold (default 0.05). Exits with 1 when
+// any row regressed, so it can gate a change.
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: " << argv[0] << " baseline current [threshold]\n";
+        return 2;
+    }
+
+    const double threshold = argc > 3 ? std::atof(argv[3]) : 0.05;
+    BenchmarkResults baseline;
+    BenchmarkResults current;
+
+    try
+    {
+        baseline = load(argv[1]);
+        current = load(argv[2]);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << '\n';
+        return 2;
+    }
+
+    printMetadata("baseline", baseline.metadata);
+    printMetadata("current ", current.metadata);
+
+    std::map<RecordKey, const BenchmarkRecord *> baselineRecords;
+    for (const BenchmarkRecord &record : baseline.records)
+        baselineRecords[keyOf(record)] = &record;
+
+    std::size_t compared = 0;
+    std::size_t regressions = 0;
+    std::size_t improvements = 0;
+
+    for (const BenchmarkRecord &record : current.records)
+    {
+        auto match = baselineRecords.find(keyOf(record));
+        if (match == baselineRecords.end())
+            continue;
+
+        compared++;
+        const BenchmarkStatistics &before = match->second->statistics;
+        Comparison comparison = compare(before, record.statistics);
+
+        // Written this way round so that rows with missing (NaN) statistics are skipped too.
+        if (!(std::fabs(comparison.change) > threshold && std::fabs(comparison.t) > comparison.critical))
+            continue;
+
+        // Median and mean disagree on the direction: too noisy to call.
+        if ((comparison.change > 0) != (comparison.t > 0))
+            continue;
+
+        const bool regression = comparison.change > 0;
+        (regression ? regressions : improvements)++;
+
+        std::printf("%-11s %-34s %-16s %-24s n=%-9zu %10.2f -> %10.2f ns/op (%+.1f%%, t=%.1f)\n",
+                    regression ? "REGRESSION" : "improvement",
+                    record.operation.c_str(), record.container.c_str(), record.type.c_str(), record.size,
+                    before.nanosecondsPerOperation(), record.statistics.nanosecondsPerOperation(),
+                    comparison.change * 100, comparison.t);
+    }
+
+    std::cout << compared << " rows compared, " << regressions << " regressions, "
+              << improvements << " improvements (threshold " << threshold * 100 << "%)\n";
+
+    return regressions > 0 ? 1 : 0;
+}
@@ -1,15 +1,77 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <cstddef>
+#include <cstdio>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <thread>
+#include <random>
+#include <vector>
+
+#include <pthread.h>
 
 #include "Vector.h"
 #include "LinkedList.h"
+#include "ForwardList.h"
+#include "Deque.h"
+#include "TieredVector.h"
+#include "BTreeSequence.h"
+#include "Benchmark.h"
+#include "OperationMatrix.h"
+#include "BenchmarkResults.h"
+#include "MemoryFootprint.h"
+#include "ContainerAdapters.h"
+#include "CrossoverFinder.h"
+#include "LatencyHistogram.h"
+#include "CacheSweep.h"
+#include "HeapFragmentation.h"
+#include "MpscQueue.h"
+#include "ConcurrentVector.h"
+#include "SegmentedVector.h"
+#include "SharedVector.h"
+#include "RcuVector.h"
+#include "PersistentVector.h"
 
-using namespace std;
+using std::cout;
 using namespace aisdi;
 using vector = aisdi::Vector<long long>;
 using list = aisdi::LinkedList<long long>;
+using forward_list = aisdi::ForwardList<long long>;
+using pooled_forward_list = aisdi::ForwardList<long long, true>;
+using deque = aisdi::Deque<long long>;
+using tiered_vector = aisdi::TieredVector<long long>;
+using segmented_vector = aisdi::SegmentedVector<long long>;
+using shared_vector = aisdi::SharedVector<long long>;
+using persistent_vector = aisdi::PersistentVector<long long>;
+using btree_sequence = aisdi::BTreeSequence<long long>;
+using std_vector = aisdi::StdVector<long long>;
+using std_list = aisdi::StdList<long long>;
+using std_deque = aisdi::StdDeque<long long>;
+
+struct indexed_list : list
+{
+    indexed_list()
+    {
+        enableIndex();
+    }
+};
+
+struct incremental_vector : vector
+{
+    incremental_vector()
+    {
+        enableIncrementalGrowth();
+    }
+};
 
 template <class Collection>
 void testPrepend(long long n)
@@ -18,6 +80,8 @@ void testPrepend(long long n)
 
     for (long long i = 0; i < n; ++i)
         collection.prepend(i);
+
+    doNotOptimize(collection);
 }
 
 template <class Collection>
@@ -27,43 +91,1232 @@ void testAppend(long long n)
 
     for (long long i = 0; i < n; ++i)
         collection.append(i);
+
+    doNotOptimize(collection);
 }
 
-void testCollectionsAppend(long long repeatCount)
+template <class Collection>
+void testQueueChurn(long long n)
+{
+    Collection collection;
+
+    for (long long i = 0; i < n; ++i)
+        collection.append(i);
+
+    for (long long i = 0; i < n; ++i)
+    {
+        collection.append(i);
+        doNotOptimize(collection.popFirst());
+    }
+}
+
+template <class Collection>
+void testRandomInsert(long long n)
+{
+    Collection collection;
+    std::mt19937_64 random(n);
+
+    for (long long i = 0; i < n; ++i)
+        collection.insert(collection.begin() + random() % (i + 1), i);
+
+    doNotOptimize(collection);
+}
+
+Benchmark benchmark;
+BenchmarkResults results;
+std::string section;
+std::map<std::string, BenchmarkStatistics> sectionStatistics;
+
+// Human-readable tables; silenced when a machine-readable format is chosen.
+std::ostream tables(cout.rdbuf());
+
+void beginSection(const std::string &title)
+{
+    section = title;
+    sectionStatistics.clear();
+    Benchmark::printHeader(tables, title);
+}
+
+// Flags a result more than OperationMatrix's slowdown limit behind the
+// baseline measured earlier in the same section.
+std::string compareWithBaseline(const BenchmarkStatistics &statistics, const std::string &baseline)
+{
+    auto reference = sectionStatistics.find(baseline);
+    if (reference == sectionStatistics.end() || reference->second.median <= 0)
+        return "";
+
+    double slowdown = statistics.median / reference->second.median - 1;
+    if (slowdown <= OperationMatrix<LongLongPayload>::SLOWDOWN_LIMIT)
+        return "";
+
+    return "!! +" + std::to_string(static_cast<int>(slowdown * 100)) + "% vs " + baseline;
+}
+
+void measure(const std::string &label, void (*scenario)(long long), long long n,
+             const std::string &baseline = "")
 {
-    cout << "append:\n";
-    clock_t time = clock();
-    testAppend<vector>(repeatCount);
-    time = clock() - time;
-    cout << "vector: " << ((float)time)/CLOCKS_PER_SEC << endl;
+    BenchmarkStatistics statistics = benchmark.run([=]() { scenario(n); }, n);
+    Benchmark::printRow(tables, label, statistics, compareWithBaseline(statistics, baseline));
+    sectionStatistics[label] = statistics;
+
+    BenchmarkRecord record;
+    record.operation = section;
+    record.container = label;
+    record.type = LongLongPayload::name();
+    record.size = n;
+    record.statistics = statistics;
+    results.add(record);
+}
 
-    time = clock();
-    testAppend<list>(repeatCount);
-    time = clock() - time;
-    cout << "list:   " << ((float)time)/CLOCKS_PER_SEC << endl;
+void testCollectionsAppend(long long repeatCount)
+{
+    beginSection("append");
+    measure("std::vector", testAppend<std_vector>, repeatCount);
+    measure("std::list", testAppend<std_list>, repeatCount);
+    measure("std::deque", testAppend<std_deque>, repeatCount);
+    measure("vector", testAppend<vector>, repeatCount, "std::vector");
+    measure("list", testAppend<list>, repeatCount, "std::list");
+    measure("deque", testAppend<deque>, repeatCount, "std::deque");
+    measure("segmented vector", testAppend<segmented_vector>, repeatCount, "vector");
+    measure("b+tree", testAppend<btree_sequence>, repeatCount);
 }
 
 void testCollectionsPrepend(long long repeatCount)
 {
-    cout << "\nprepend:\n";
-    clock_t time = clock();
-    testPrepend<vector>(repeatCount);
-    time = clock() - time;
-    cout << "vector: " << ((float)time)/CLOCKS_PER_SEC << endl;
+    beginSection("prepend");
+    measure("std::vector", testPrepend<std_vector>, repeatCount);
+    measure("std::list", testPrepend<std_list>, repeatCount);
+    measure("std::deque", testPrepend<std_deque>, repeatCount);
+    measure("vector", testPrepend<vector>, repeatCount, "std::vector");
+    measure("list", testPrepend<list>, repeatCount, "std::list");
+    measure("deque", testPrepend<deque>, repeatCount, "std::deque");
+    measure("b+tree", testPrepend<btree_sequence>, repeatCount);
+}
+
+void testCollectionsQueueChurn(long long repeatCount)
+{
+    beginSection("queue churn");
+    measure("std::list", testQueueChurn<std_list>, repeatCount);
+    measure("std::deque", testQueueChurn<std_deque>, repeatCount);
+    measure("list", testQueueChurn<list>, repeatCount, "std::list");
+    measure("forward list", testQueueChurn<forward_list>, repeatCount);
+    measure("pooled forward list", testQueueChurn<pooled_forward_list>, repeatCount);
+}
 
-    time = clock();
-    testPrepend<list>(repeatCount);
-    time = clock() - time;
-    cout << "list:   " << ((float)time)/CLOCKS_PER_SEC;
+void testCollectionsRandomInsert(long long repeatCount)
+{
+    beginSection("random position insert");
+    measure("std::vector", testRandomInsert<std_vector>, repeatCount);
+    measure("std::list", testRandomInsert<std_list>, repeatCount);
+    measure("vector", testRandomInsert<vector>, repeatCount, "std::vector");
+    measure("list", testRandomInsert<list>, repeatCount, "std::list");
+    measure("indexed list", testRandomInsert<indexed_list>, repeatCount);
+    measure("tiered vector", testRandomInsert<tiered_vector>, repeatCount);
+    measure("b+tree", testRandomInsert<btree_sequence>, repeatCount);
 }
 
-int main(int argc, char** argv)
+template <class Payload>
+void testOperationMatrix(std::size_t maxSize)
+{
+    OperationMatrix<Payload> matrix(decadeSizes(maxSize), benchmark.getSettings());
+    matrix.template addContender<StdVector>("std::vector");
+    matrix.template addContender<Vector>("vector", "std::vector");
+    matrix.template addContender<StdList>("std::list");
+    matrix.template addContender<LinkedList>("list", "std::list");
+    matrix.template addContender<StdDeque>("std::deque");
+    matrix.template addContender<Deque>("deque", "std::deque");
+    matrix.run(tables, &results);
+}
+
+void testElementTypes(std::size_t maxSize)
+{
+    testOperationMatrix<Int32Payload>(maxSize);
+    testOperationMatrix<LongLongPayload>(maxSize);
+    testOperationMatrix<ShortStringPayload>(maxSize);
+    testOperationMatrix<LongStringPayload>(maxSize);
+    testOperationMatrix<BlobPayload<64>>(maxSize);
+    testOperationMatrix<BlobPayload<256>>(maxSize);
+    testOperationMatrix<CountingObjectPayload>(maxSize);
+}
+
+template <class Payload>
+void testMemoryFootprint(std::size_t maxSize)
+{
+    MemoryFootprint<Payload> footprint(decadeSizes(maxSize));
+    footprint.template addContender<StdVector>("std::vector");
+    footprint.template addContender<Vector>("vector");
+    footprint.template addContender<StdList>("std::list");
+    footprint.template addContender<LinkedList>("list");
+    footprint.template addContender<StdDeque>("std::deque");
+    footprint.template addContender<Deque>("deque");
+    footprint.run(tables, &results);
+}
+
+void testElementTypesMemory(std::size_t maxSize)
+{
+    testMemoryFootprint<Int32Payload>(maxSize);
+    testMemoryFootprint<LongLongPayload>(maxSize);
+    testMemoryFootprint<ShortStringPayload>(maxSize);
+    testMemoryFootprint<LongStringPayload>(maxSize);
+    testMemoryFootprint<BlobPayload<64>>(maxSize);
+    testMemoryFootprint<BlobPayload<256>>(maxSize);
+    testMemoryFootprint<CountingObjectPayload>(maxSize);
+}
+
+void findCrossovers(std::size_t maxSize, const std::string &tablePath)
+{
+    CrossoverFinder finder(maxSize, benchmark.getSettings());
+    finder.addElementSize<LongLongPayload>();
+    finder.addElementSize<BlobPayload<32>>();
+    finder.addElementSize<BlobPayload<128>>();
+    finder.addElementSize<BlobPayload<512>>();
+    finder.run(tables, &results);
+
+    if (tablePath.empty())
+    {
+        tables << '\n';
+        finder.writeTable(tables);
+        return;
+    }
+
+    std::ofstream table(tablePath);
+    finder.writeTable(table);
+    if (!table)
+        std::cerr << "cannot write " << tablePath << '\n';
+}
+
+// Appends are timed one by one, over a few fresh collections, so that the
+// rare appends that grow a buffer show in the tail rather than the mean.
+// Growth happens at the same appends in every round while preemption does
+// not, so the reported max is the median of the rounds' maxima.
+template<class Collection>
+void measureAppendLatency(const std::string &label, std::size_t count)
+{
+    static const std::size_t ROUNDS = 5;
+    LatencyHistogram histogram;
+    std::vector<std::uint64_t> maxima;
+
+    for (std::size_t round = 0; round < ROUNDS; round++)
+    {
+        Collection collection;
+        LatencyHistogram roundHistogram = recordLatencies(count, [&collection](std::size_t i) {
+            collection.append(static_cast<long long>(i));
+        });
+        doNotOptimize(collection);
+
+        histogram += roundHistogram;
+        maxima.push_back(roundHistogram.getMax());
+    }
+
+    std::sort(maxima.begin(), maxima.end());
+    LatencySummary latency = histogram.summarize(TickClock::ticksPerNanosecond());
+    latency.max = maxima[ROUNDS / 2] / TickClock::ticksPerNanosecond();
+    tables << std::left << std::setw(22) << label << std::right
+           << std::setw(12) << Benchmark::formatSeconds(latency.mean * 1e-9)
+           << std::setw(12) << Benchmark::formatSeconds(latency.p50 * 1e-9)
+           << std::setw(12) << Benchmark::formatSeconds(latency.p99 * 1e-9)
+           << std::setw(12) << Benchmark::formatSeconds(latency.p999 * 1e-9)
+           << std::setw(12) << Benchmark::formatSeconds(latency.p9999 * 1e-9)
+           << std::setw(12) << Benchmark::formatSeconds(latency.max * 1e-9) << '\n';
+
+    BenchmarkRecord record;
+    record.operation = "append latency";
+    record.container = label;
+    record.type = LongLongPayload::name();
+    record.size = count;
+    record.latency = latency;
+    results.add(record);
+}
+
+void testAppendLatency(std::size_t count)
+{
+    tables << "\nappend latency, per operation over " << count << " appends ("
+           << TickClock::source() << ", " << std::setprecision(3)
+           << TickClock::overhead() / TickClock::ticksPerNanosecond() << " ns timer overhead included):\n";
+    tables << std::left << std::setw(22) << "container" << std::right << std::setw(12) << "mean"
+           << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "p99.9"
+           << std::setw(12) << "p99.99" << std::setw(12) << "max" << '\n';
+
+    measureAppendLatency<std_vector>("std::vector", count);
+    measureAppendLatency<vector>("vector", count);
+    measureAppendLatency<incremental_vector>("incremental vector", count);
+    measureAppendLatency<segmented_vector>("segmented vector", count);
+    measureAppendLatency<std_deque>("std::deque", count);
+    measureAppendLatency<deque>("deque", count);
+    measureAppendLatency<std_list>("std::list", count);
+    measureAppendLatency<list>("list", count);
+    measureAppendLatency<tiered_vector>("tiered vector", count);
+    measureAppendLatency<btree_sequence>("b+tree", count);
+}
+
+template <class Payload>
+void testCacheSweep(const CacheHierarchy &hierarchy, std::size_t maxBytes)
+{
+    CacheSweep<Payload> sweep(hierarchy, maxBytes, benchmark.getSettings());
+    sweep.template addContender<Vector>("vector");
+    sweep.template addContender<SegmentedVector>("segmented vector");
+    sweep.template addContender<LinkedList>("list");
+    sweep.run(tables, &results);
+}
+
+void testElementTypesCacheSweep(std::size_t maxBytes)
+{
+    CacheHierarchy hierarchy = CacheHierarchy::detect();
+
+    tables << "\ndata caches of cpu0:";
+    for (const CacheLevel &level : hierarchy.getLevels())
+        tables << ' ' << level.name() << ' ' << level.bytes / 1024 << " KiB";
+    if (hierarchy.isEmpty())
+        tables << " unknown (no sysfs), sweeping a single working set";
+    tables << '\n';
+
+    testCacheSweep<Int32Payload>(hierarchy, maxBytes);
+    testCacheSweep<LongLongPayload>(hierarchy, maxBytes);
+    testCacheSweep<ShortStringPayload>(hierarchy, maxBytes);
+    testCacheSweep<LongStringPayload>(hierarchy, maxBytes);
+    testCacheSweep<BlobPayload<64>>(hierarchy, maxBytes);
+    testCacheSweep<BlobPayload<256>>(hierarchy, maxBytes);
+    testCacheSweep<CountingObjectPayload>(hierarchy, maxBytes);
+}
+
+// Traversal and erase-while-iterating (every other element) per element,
+// over collections built in each heap layout, with the locality of the
+// resulting nodes. afterBuild, if given, runs on every collection built,
+// outside of the timings.
+template<class Collection>
+void measureFragmentation(const std::string &label, HeapLayout layout, std::size_t size,
+                          const std::function<void(Collection &)> &afterBuild = nullptr)
+{
+    FragmentedHeap heap;
+    std::unique_ptr<Collection> collection(new Collection);
+    heap.build(*collection, layout, size);
+    if (afterBuild)
+        afterBuild(*collection);
+    NodeLocality locality = measureLocality(*collection);
+
+    BenchmarkStatistics iteration = benchmark.run([&collection]() {
+        long long sum = 0;
+        for (long long value : *collection)
+            sum += value;
+        doNotOptimize(sum);
+    }, size);
+
+    BenchmarkStatistics erasure = benchmark.run([&]() {
+        // The old nodes go first, or the new ones would reuse them.
+        collection.reset();
+        collection.reset(new Collection);
+        heap.build(*collection, layout, size);
+        if (afterBuild)
+            afterBuild(*collection);
+    }, [&collection]() {
+        bool erase = true;
+        for (auto position = collection->begin(); position != collection->end(); erase = !erase)
+        {
+            if (erase)
+                eraseAndAdvance(*collection, position);
+            else
+                ++position;
+        }
+    }, size);
+
+    char samePage[32];
+    std::snprintf(samePage, sizeof(samePage), "%.1f%%", locality.samePageShare * 100);
+
+    tables << std::left << std::setw(22) << heapLayoutName(layout) << std::setw(14) << label << std::right
+           << std::setw(14) << Benchmark::formatBytes(locality.averageStride) << std::setw(12) << samePage
+           << std::setw(14) << Benchmark::formatSeconds(iteration.nanosecondsPerOperation() * 1e-9)
+           << std::setw(14) << Benchmark::formatSeconds(erasure.nanosecondsPerOperation() * 1e-9) << '\n';
+
+    BenchmarkRecord record;
+    record.container = label;
+    record.type = LongLongPayload::name();
+    record.size = size;
+    record.operation = std::string("iterate, ") + heapLayoutName(layout);
+    record.statistics = iteration;
+    results.add(record);
+    record.operation = std::string("erase while iterating, ") + heapLayoutName(layout);
+    record.statistics = erasure;
+    results.add(record);
+}
+
+void testHeapFragmentation(std::size_t size)
+{
+    tables << "\nheap fragmentation, " << size << " elements, " << NodeLocality::pageSize() << " B pages:\n";
+    tables << std::left << std::setw(22) << "layout" << std::setw(14) << "container" << std::right
+           << std::setw(14) << "mean stride" << std::setw(12) << "same page"
+           << std::setw(14) << "iterate/elem" << std::setw(14) << "erase/elem" << '\n';
+
+    for (HeapLayout layout : allHeapLayouts())
+    {
+        measureFragmentation<list>("list", layout, size);
+        measureFragmentation<list>("list compact", layout, size, [](list &collection) {
+            collection.compact();
+        });
+        measureFragmentation<std_list>("std::list", layout, size);
+    }
+}
+
+// Sums with forEach and with iterators, copy and destruction of a list
+// built in the given heap layout, per element, with prefetching distance
+// nodes ahead (0 turns it off).
+void measurePrefetch(HeapLayout layout, std::size_t distance, std::size_t size)
+{
+    FragmentedHeap heap;
+    std::unique_ptr<list> collection(new list);
+    heap.build(*collection, layout, size);
+    collection->setPrefetchDistance(distance);
+
+    BenchmarkStatistics forEachSum = benchmark.run([&collection]() {
+        long long sum = 0;
+        collection->forEach([&sum](long long value) {
+            sum += value;
+        });
+        doNotOptimize(sum);
+    }, size);
+
+    BenchmarkStatistics iteratorSum = benchmark.run([&collection]() {
+        long long sum = 0;
+        for (long long value : *collection)
+            sum += value;
+        doNotOptimize(sum);
+    }, size);
+
+    std::unique_ptr<list> copy;
+    BenchmarkStatistics copying = benchmark.run([&copy]() {
+        copy.reset();
+    }, [&collection, &copy]() {
+        copy.reset(new list(*collection));
+    }, size);
+    copy.reset();
+
+    BenchmarkStatistics destruction = benchmark.run([&]() {
+        collection.reset();
+        collection.reset(new list);
+        heap.build(*collection, layout, size);
+        collection->setPrefetchDistance(distance);
+    }, [&collection]() {
+        collection.reset();
+    }, size);
+
+    tables << std::left << std::setw(22) << heapLayoutName(layout) << std::right << std::setw(10) << distance;
+    for (const BenchmarkStatistics *statistics : {&forEachSum, &iteratorSum, &copying, &destruction})
+        tables << std::setw(14) << Benchmark::formatSeconds(statistics->nanosecondsPerOperation() * 1e-9);
+    tables << '\n';
+
+    const std::string suffix = std::string(", ") + heapLayoutName(layout) + ", prefetch " + std::to_string(distance);
+    BenchmarkRecord record;
+    record.container = "list";
+    record.type = LongLongPayload::name();
+    record.size = size;
+    record.operation = "forEach sum" + suffix;
+    record.statistics = forEachSum;
+    results.add(record);
+    record.operation = "iterator sum" + suffix;
+    record.statistics = iteratorSum;
+    results.add(record);
+    record.operation = "copy" + suffix;
+    record.statistics = copying;
+    results.add(record);
+    record.operation = "destroy" + suffix;
+    record.statistics = destruction;
+    results.add(record);
+}
+
+void testPrefetch(std::size_t size)
+{
+    static const std::size_t distances[] = {0, 1, 2, 4, 8};
+
+    tables << "\nlist prefetching, " << size << " elements, ns per element:\n";
+    tables << std::left << std::setw(22) << "layout" << std::right << std::setw(10) << "distance"
+           << std::setw(14) << "forEach sum" << std::setw(14) << "iterator sum"
+           << std::setw(14) << "copy" << std::setw(14) << "destroy" << '\n';
+
+    for (HeapLayout layout : {HeapLayout::FRESH, HeapLayout::SHUFFLED_INSERTION})
+        for (std::size_t distance : distances)
+            measurePrefetch(layout, distance, size);
+}
+
+// The way a LinkedList serves as a work queue today: every push and pop
+// under one mutex.
+struct locked_list_queue
+{
+    struct Producer
+    {
+        locked_list_queue &queue;
+
+        void push(long long item)
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.items.append(item);
+        }
+    };
+
+    std::mutex mutex;
+    list items;
+
+    Producer addProducer()
+    {
+        return Producer{*this};
+    }
+
+    bool tryPop(long long &item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.isEmpty())
+            return false;
+
+        item = items.popFirst();
+        return true;
+    }
+};
+
+// MpscQueue pushed to without Producer handles, so every node is new'd.
+struct unpooled_mpsc_queue
+{
+    struct Producer
+    {
+        MpscQueue<long long> &queue;
+
+        void push(long long item)
+        {
+            queue.push(item);
+        }
+    };
+
+    MpscQueue<long long> queue;
+
+    Producer addProducer()
+    {
+        return Producer{queue};
+    }
+
+    bool tryPop(long long &item)
+    {
+        return queue.tryPop(item);
+    }
+};
+
+// producers threads push itemsPerProducer items each while this thread
+// pops them all; timed per item, thread start-up included.
+template<class Queue>
+BenchmarkStatistics measureQueue(const Benchmark &runner, std::size_t producers, std::size_t itemsPerProducer)
+{
+    return runner.run([producers, itemsPerProducer]() {
+        Queue queue;
+        std::atomic<bool> start(false);
+        std::vector<std::thread> threads;
+
+        for (std::size_t p = 0; p < producers; p++)
+        {
+            threads.emplace_back([&queue, &start, itemsPerProducer]() {
+                auto &&producer = queue.addProducer();
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                for (std::size_t i = 0; i < itemsPerProducer; i++)
+                    producer.push(static_cast<long long>(i));
+            });
+        }
+
+        start.store(true, std::memory_order_release);
+
+        long long item = 0, sum = 0;
+        for (std::size_t received = 0; received < producers * itemsPerProducer; )
+        {
+            if (queue.tryPop(item))
+            {
+                sum += item;
+                received++;
+            }
+        }
+        doNotOptimize(sum);
+
+        for (std::thread &thread : threads)
+            thread.join();
+    }, producers * itemsPerProducer);
+}
+
+void testQueueContention(std::size_t itemsPerProducer)
+{
+    static const std::size_t producerCounts[] = {1, 2, 4, 8};
+    const Benchmark runner(benchmark.getSettings().relaxed());
+
+    tables << "\nproducers x 1 consumer, " << itemsPerProducer << " items per producer, "
+           << std::thread::hardware_concurrency() << " hardware threads:\n";
+    tables << std::right << std::setw(10) << "producers" << std::setw(22) << "queue"
+           << std::setw(14) << "per item" << std::setw(16) << "items/s" << '\n';
+
+    for (std::size_t producers : producerCounts)
+    {
+        const std::pair<const char *, BenchmarkStatistics> rows[] = {
+                {"mutex + list", measureQueue<locked_list_queue>(runner, producers, itemsPerProducer)},
+                {"mpsc, new nodes", measureQueue<unpooled_mpsc_queue>(runner, producers, itemsPerProducer)},
+                {"mpsc, producer pools", measureQueue<MpscQueue<long long>>(runner, producers, itemsPerProducer)}
+        };
+
+        for (const auto &row : rows)
+        {
+            char itemsPerSecond[32];
+            std::snprintf(itemsPerSecond, sizeof(itemsPerSecond), "%.3g", row.second.operationsPerSecond());
+            tables << std::right << std::setw(10) << producers << std::setw(22) << row.first
+                   << std::setw(14) << Benchmark::formatSeconds(row.second.nanosecondsPerOperation() * 1e-9)
+                   << std::setw(16) << itemsPerSecond << '\n';
+
+            BenchmarkRecord record;
+            record.operation = "push and pop, " + std::to_string(producers) + " producers";
+            record.container = row.first;
+            record.type = LongLongPayload::name();
+            record.size = producers * itemsPerProducer;
+            record.statistics = row.second;
+            results.add(record);
+        }
+    }
+}
+
+// Appends from several threads to one Vector, under a mutex.
+struct locked_vector
+{
+    std::mutex mutex;
+    vector items;
+
+    void append(long long item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.append(item);
+    }
+};
+
+struct reserved_concurrent_vector : ConcurrentVector<long long>
+{
+    explicit reserved_concurrent_vector(std::size_t count)
+    {
+        reserve(count);
+    }
+};
+
+// threads threads append count elements between them into one
+// collection; timed per append, thread start-up included.
+template<class Collection>
+BenchmarkStatistics measureConcurrentAppend(const Benchmark &runner, std::size_t threads, std::size_t count)
+{
+    std::unique_ptr<Collection> collection;
+
+    return runner.run([&collection, count]() {
+        collection.reset();
+        collection.reset(new Collection(count));
+    }, [&collection, threads, count]() {
+        std::atomic<bool> start(false);
+        std::vector<std::thread> appenders;
+
+        for (std::size_t t = 0; t < threads; t++)
+        {
+            std::size_t first = count * t / threads, last = count * (t + 1) / threads;
+            appenders.emplace_back([&collection, &start, first, last]() {
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                for (std::size_t i = first; i < last; i++)
+                    collection->append(static_cast<long long>(i));
+            });
+        }
+
+        start.store(true, std::memory_order_release);
+        for (std::thread &appender : appenders)
+            appender.join();
+    }, count);
+}
+
+// Collections for measureConcurrentAppend, which hands them the count.
+template<class Collection>
+struct sized : Collection
+{
+    explicit sized(std::size_t)
+    {}
+};
+
+void testConcurrentAppend(std::size_t count)
+{
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> threadCounts;
+    for (std::size_t threads = 1; threads < cores; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(cores);
+
+    const Benchmark runner(benchmark.getSettings().relaxed());
+
+    tables << "\nconcurrent append, " << count << " elements in total, " << cores << " hardware threads:\n";
+    tables << std::right << std::setw(10) << "threads" << std::setw(28) << "collection"
+           << std::setw(14) << "per append" << std::setw(10) << "speedup" << '\n';
+
+    std::map<std::string, double> singleThreaded;
+
+    for (std::size_t threads : threadCounts)
+    {
+        const std::pair<const char *, BenchmarkStatistics> rows[] = {
+                {"mutex + vector", measureConcurrentAppend<sized<locked_vector>>(runner, threads, count)},
+                {"concurrent vector", measureConcurrentAppend<sized<ConcurrentVector<long long>>>(
+                        runner, threads, count)},
+                {"concurrent vector, reserved", measureConcurrentAppend<reserved_concurrent_vector>(
+                        runner, threads, count)}
+        };
+
+        for (const auto &row : rows)
+        {
+            const double nanoseconds = row.second.nanosecondsPerOperation();
+            if (threads == 1)
+                singleThreaded[row.first] = nanoseconds;
+
+            char speedup[32];
+            std::snprintf(speedup, sizeof(speedup), "%.2fx", singleThreaded[row.first] / nanoseconds);
+            tables << std::right << std::setw(10) << threads << std::setw(28) << row.first
+                   << std::setw(14) << Benchmark::formatSeconds(nanoseconds * 1e-9)
+                   << std::setw(10) << speedup << '\n';
+
+            BenchmarkRecord record;
+            record.operation = "concurrent append, " + std::to_string(threads) + " threads";
+            record.container = row.first;
+            record.type = LongLongPayload::name();
+            record.size = count;
+            record.statistics = row.second;
+            results.add(record);
+        }
+    }
+}
+
+// A writer updating a size-element collection that hands a snapshot of
+// it to readers after every writesPerSnapshot updates. Readers keep the
+// last HELD snapshots alive while the writer goes on, as when a pipeline
+// passes the collection by value; timed per snapshot, updates included.
+template<class Collection>
+BenchmarkStatistics measureSnapshots(const Benchmark &runner, std::size_t size, std::size_t writesPerSnapshot)
+{
+    static const std::size_t SNAPSHOTS = 200;
+    static const std::size_t HELD = 4;
+
+    Collection collection;
+    for (std::size_t i = 0; i < size; i++)
+        collection.append(static_cast<long long>(i));
+
+    return runner.run([&collection, size, writesPerSnapshot]() {
+        std::vector<Collection> held(HELD);
+        long long checksum = 0;
+
+        for (std::size_t snapshot = 0; snapshot < SNAPSHOTS; snapshot++)
+        {
+            Collection &reader = held[snapshot % HELD];
+            reader = collection;
+            checksum += *static_cast<const Collection&>(reader).begin();
+
+            for (std::size_t write = 0; write < writesPerSnapshot; write++)
+                *(collection.begin() + (snapshot * 31 + write * 17) % size) = static_cast<long long>(write);
+        }
+
+        doNotOptimize(checksum);
+    }, SNAPSHOTS);
+}
+
+void testSnapshots(std::size_t size)
+{
+    const Benchmark runner(benchmark.getSettings().relaxed());
+
+    tables << "\nsnapshots of a " << size << "-element collection, per snapshot:\n";
+    tables << std::right << std::setw(18) << "writes/snapshot" << std::setw(16) << "collection"
+           << std::setw(14) << "per snapshot" << std::setw(10) << "speedup" << '\n';
+
+    for (std::size_t writes : {0, 1, 100})
+    {
+        const std::pair<const char *, BenchmarkStatistics> rows[] = {
+                {"vector", measureSnapshots<vector>(runner, size, writes)},
+                {"shared vector", measureSnapshots<shared_vector>(runner, size, writes)}
+        };
+
+        for (const auto &row : rows)
+        {
+            const double nanoseconds = row.second.nanosecondsPerOperation();
+            char speedup[32];
+            std::snprintf(speedup, sizeof(speedup), "%.2fx",
+                          rows[0].second.nanosecondsPerOperation() / nanoseconds);
+            tables << std::right << std::setw(18) << writes << std::setw(16) << row.first
+                   << std::setw(14) << Benchmark::formatSeconds(nanoseconds * 1e-9)
+                   << std::setw(10) << speedup << '\n';
+
+            BenchmarkRecord record;
+            record.operation = "snapshot, " + std::to_string(writes) + " writes";
+            record.container = row.first;
+            record.type = LongLongPayload::name();
+            record.size = size;
+            record.statistics = row.second;
+            results.add(record);
+        }
+    }
+}
+
+// A Vector behind a reader-writer lock; readers share it, a writer
+// excludes everyone. pthread_rwlock_t is what std::shared_mutex wraps on
+// Linux, which this C++11 build cannot name.
+struct rwlocked_vector
+{
+    pthread_rwlock_t lock;
+    vector items;
+
+    explicit rwlocked_vector(std::size_t size)
+    {
+        pthread_rwlock_init(&lock, nullptr);
+        for (std::size_t i = 0; i < size; i++)
+            items.append(static_cast<long long>(i));
+    }
+
+    ~rwlocked_vector()
+    {
+        pthread_rwlock_destroy(&lock);
+    }
+
+    // Every thread reads through the collection itself.
+    rwlocked_vector &addReader()
+    {
+        return *this;
+    }
+
+    template<typename Visit>
+    void read(Visit visit)
+    {
+        pthread_rwlock_rdlock(&lock);
+        visit(static_cast<const vector&>(items));
+        pthread_rwlock_unlock(&lock);
+    }
+
+    template<typename Update>
+    void update(Update update)
+    {
+        pthread_rwlock_wrlock(&lock);
+        update(items);
+        pthread_rwlock_unlock(&lock);
+    }
+};
+
+struct rcu_vector : RcuVector<long long>
+{
+    explicit rcu_vector(std::size_t size)
+        : RcuVector<long long>(filled(size))
+    {}
+
+    static shared_vector filled(std::size_t size)
+    {
+        shared_vector items;
+        for (std::size_t i = 0; i < size; i++)
+            items.append(static_cast<long long>(i));
+        return items;
+    }
+};
+
+// Sums a collection through its const iterator, which for Vector, unlike
+// end(), writes nothing and so may run in several readers at once.
+struct sum_items
+{
+    long long &sum;
+
+    template<class Collection>
+    void operator()(const Collection &collection) const
+    {
+        auto it = collection.begin();
+        for (std::size_t i = 0; i < collection.getSize(); i++, ++it)
+            sum += *it;
+    }
+};
+
+struct overwrite_item
+{
+    std::size_t index;
+    long long value;
+
+    template<class Collection>
+    void operator()(Collection &collection) const
+    {
+        *(collection.begin() + index) = value;
+    }
+};
+
+// readers threads each scan a size-element collection scans times while
+// a writer overwrites an element every writeInterval; timed per scan.
+// writes receives how many updates went through in the last run.
+template<class Collection>
+BenchmarkStatistics measureReadMostly(const Benchmark &runner, std::size_t readers, std::size_t size,
+                                      std::size_t scans, std::chrono::microseconds writeInterval,
+                                      std::size_t &writes)
+{
+    return runner.run([readers, size, scans, writeInterval, &writes]() {
+        Collection collection(size);
+        std::atomic<std::size_t> running(readers);
+        std::vector<std::thread> threads;
+
+        for (std::size_t r = 0; r < readers; r++)
+        {
+            threads.emplace_back([&collection, &running, scans]() {
+                auto &reader = collection.addReader();
+                long long sum = 0;
+
+                for (std::size_t scan = 0; scan < scans; scan++)
+                    reader.read(sum_items{sum});
+
+                doNotOptimize(sum);
+                running--;
+            });
+        }
+
+        writes = 0;
+        while (running.load() > 0)
+        {
+            std::this_thread::sleep_for(writeInterval);
+            collection.update(overwrite_item{writes % size, static_cast<long long>(writes)});
+            writes++;
+        }
+
+        for (std::thread &thread : threads)
+            thread.join();
+    }, readers * scans);
+}
+
+void testReadMostly(std::size_t size)
+{
+    static const std::size_t readerCounts[] = {1, 2, 4, 8};
+    static const std::size_t SCANS = 2000;
+    const std::chrono::microseconds writeInterval(100);
+    const Benchmark runner(benchmark.getSettings().relaxed());
+
+    tables << "\nreaders scanning a " << size << "-element collection, a write every "
+           << writeInterval.count() << " us, " << std::thread::hardware_concurrency() << " hardware threads:\n";
+    tables << std::right << std::setw(10) << "readers" << std::setw(18) << "collection"
+           << std::setw(14) << "per scan" << std::setw(16) << "scans/s" << std::setw(10) << "writes" << '\n';
+
+    for (std::size_t readers : readerCounts)
+    {
+        std::size_t lockedWrites = 0, rcuWrites = 0;
+        const std::pair<const char *, BenchmarkStatistics> rows[] = {
+                {"rwlock + vector", measureReadMostly<rwlocked_vector>(runner, readers, size, SCANS,
+                                                                       writeInterval, lockedWrites)},
+                {"rcu vector", measureReadMostly<rcu_vector>(runner, readers, size, SCANS,
+                                                             writeInterval, rcuWrites)}
+        };
+        const std::size_t writes[] = {lockedWrites, rcuWrites};
+
+        for (std::size_t row = 0; row < 2; row++)
+        {
+            const BenchmarkStatistics &statistics = rows[row].second;
+            char scansPerSecond[32];
+            std::snprintf(scansPerSecond, sizeof(scansPerSecond), "%.3g", statistics.operationsPerSecond());
+            tables << std::right << std::setw(10) << readers << std::setw(18) << rows[row].first
+                   << std::setw(14) << Benchmark::formatSeconds(statistics.nanosecondsPerOperation() * 1e-9)
+                   << std::setw(16) << scansPerSecond << std::setw(10) << writes[row] << '\n';
+
+            BenchmarkRecord record;
+            record.operation = "read-mostly scan, " + std::to_string(readers) + " readers";
+            record.container = rows[row].first;
+            record.type = LongLongPayload::name();
+            record.size = size;
+            record.statistics = statistics;
+            results.add(record);
+        }
+    }
+}
+
+// New versions of a collection, each derived from the last as undo
+// history would: copies of a Vector against versions of a
+// PersistentVector. Prints the time per version of every operation and
+// the heap a chain of updated versions keeps alive.
+void testPersistentVersions(std::size_t size)
+{
+    static const std::size_t VERSIONS = 32;
+    const Benchmark runner(benchmark.getSettings().relaxed());
+
+    vector base;
+    persistent_vector::Builder builder;
+    for (std::size_t i = 0; i < size; i++)
+    {
+        base.append(static_cast<long long>(i));
+        builder.append(static_cast<long long>(i));
+    }
+    const persistent_vector version = builder.persistent();
+
+    std::mt19937 random(2017);
+    std::vector<std::size_t> indices;
+    for (std::size_t k = 0; k < VERSIONS; k++)
+        indices.push_back(random() % size);
+
+    struct Row
+    {
+        const char *operation;
+        BenchmarkStatistics copied;
+        BenchmarkStatistics persistent;
+    };
+
+    const Row rows[] = {
+            {"update", runner.run([&base, &indices]() {
+                vector current = base;
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                {
+                    vector next = current;
+                    *(next.begin() + indices[k]) = static_cast<long long>(k);
+                    current = std::move(next);
+                }
+                doNotOptimize(current);
+            }, VERSIONS), runner.run([&version, &indices]() {
+                persistent_vector current = version;
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                    current = current.set(indices[k], static_cast<long long>(k));
+                doNotOptimize(current);
+            }, VERSIONS)},
+            {"append", runner.run([&base]() {
+                vector current = base;
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                {
+                    vector next = current;
+                    next.append(static_cast<long long>(k));
+                    current = std::move(next);
+                }
+                doNotOptimize(current);
+            }, VERSIONS), runner.run([&version]() {
+                persistent_vector current = version;
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                    current = current.append(static_cast<long long>(k));
+                doNotOptimize(current);
+            }, VERSIONS)},
+            {"concat with itself", runner.run([&base]() {
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                {
+                    vector joined = base;
+                    for (auto it = base.begin(); it != base.end(); ++it)
+                        joined.append(*it);
+                    doNotOptimize(joined);
+                }
+            }, VERSIONS), runner.run([&version]() {
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                    doNotOptimize(version.concat(version));
+            }, VERSIONS)},
+            {"slice middle half", runner.run([&base, size]() {
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                {
+                    vector sliced;
+                    auto it = base.begin() + size / 4;
+                    for (std::size_t i = size / 4; i < size * 3 / 4; i++, ++it)
+                        sliced.append(*it);
+                    doNotOptimize(sliced);
+                }
+            }, VERSIONS), runner.run([&version, size]() {
+                for (std::size_t k = 0; k < VERSIONS; k++)
+                    doNotOptimize(version.slice(size / 4, size * 3 / 4));
+            }, VERSIONS)}
+    };
+
+    // A chain of VERSIONS updated versions, all kept.
+    long long copiedBytes, persistentBytes;
+    {
+        std::vector<vector> versions;
+        versions.reserve(VERSIONS + 1);
+        AllocationScope scope;
+        versions.push_back(base);
+        for (std::size_t k = 0; k < VERSIONS; k++)
+        {
+            versions.push_back(versions.back());
+            *(versions.back().begin() + indices[k]) = static_cast<long long>(k);
+        }
+        copiedBytes = AllocationTracker::snapshot().liveHeapBytes();
+    }
+    {
+        std::vector<persistent_vector> versions;
+        versions.reserve(VERSIONS + 1);
+        versions.push_back(version);
+        AllocationScope scope;
+        for (std::size_t k = 0; k < VERSIONS; k++)
+            versions.push_back(versions.back().set(indices[k], static_cast<long long>(k)));
+        persistentBytes = AllocationTracker::snapshot().liveHeapBytes();
+    }
+
+    tables << "\nversions of a " << size << "-element collection, per version:\n";
+    tables << std::left << std::setw(22) << "operation" << std::right << std::setw(16) << "vector copy"
+           << std::setw(16) << "persistent" << std::setw(12) << "speedup" << '\n';
+
+    for (const Row &row : rows)
+    {
+        char speedup[32];
+        std::snprintf(speedup, sizeof(speedup), "%.3gx",
+                      row.copied.nanosecondsPerOperation() / row.persistent.nanosecondsPerOperation());
+        tables << std::left << std::setw(22) << row.operation << std::right
+               << std::setw(16) << Benchmark::formatSeconds(row.copied.nanosecondsPerOperation() * 1e-9)
+               << std::setw(16) << Benchmark::formatSeconds(row.persistent.nanosecondsPerOperation() * 1e-9)
+               << std::setw(12) << speedup << '\n';
+
+        for (const auto &measured : {std::make_pair("vector copy", row.copied),
+                                     std::make_pair("persistent vector", row.persistent)})
+        {
+            BenchmarkRecord record;
+            record.operation = std::string("version by ") + row.operation;
+            record.container = measured.first;
+            record.type = LongLongPayload::name();
+            record.size = size;
+            record.statistics = measured.second;
+            results.add(record);
+        }
+    }
+
+    tables << std::left << std::setw(22) << "heap per update" << std::right
+           << std::setw(14) << copiedBytes / static_cast<long long>(VERSIONS) << " B"
+           << std::setw(14) << persistentBytes / static_cast<long long>(VERSIONS) << " B" << '\n';
+}
+
+void runSuite(const std::vector<std::string> &arguments)
 {
-    long long repeatCount = argc > 1 ? std::atoll(argv[1]) : 10000;
+    if (!arguments.empty() && arguments[0] == "matrix")
+    {
+        testOperationMatrix<LongLongPayload>(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 10000000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "types")
+    {
+        // Smaller default: seven payloads, and a 256-byte element at 1e7
+        // would need gigabytes per copy.
+        testElementTypes(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 100000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "memory")
+    {
+        testElementTypesMemory(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 1000000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "crossover")
+    {
+        findCrossovers(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 100000,
+                       arguments.size() > 2 ? arguments[2] : "");
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "cache")
+    {
+        // Working sets past maxBytes are skipped; the largest caches are
+        // commonly tens or hundreds of MiB.
+        testElementTypesCacheSweep(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 256 << 20);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "fragmentation")
+    {
+        testHeapFragmentation(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 1000000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "prefetch")
+    {
+        testPrefetch(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 1000000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "mpsc")
+    {
+        testQueueContention(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 200000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "concurrent")
+    {
+        testConcurrentAppend(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 4000000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "snapshots")
+    {
+        testSnapshots(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 100000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "readmostly")
+    {
+        testReadMostly(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 10000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "persistent")
+    {
+        testPersistentVersions(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 100000);
+        return;
+    }
+
+    if (!arguments.empty() && arguments[0] == "latency")
+    {
+        testAppendLatency(arguments.size() > 1 ? std::atoll(arguments[1].c_str()) : 1000000);
+        return;
+    }
+
+    long long repeatCount = !arguments.empty() ? std::atoll(arguments[0].c_str()) : 10000;
 
     testCollectionsAppend(repeatCount);
 
     testCollectionsPrepend(repeatCount);
 
+    testCollectionsQueueChurn(repeatCount);
+
+    testCollectionsRandomInsert(repeatCount);
+}
+
+// Usage: aisdiLinear [options] [repeatCount]
+//        aisdiLinear [options] matrix [maxSize]
+//        aisdiLinear [options] types [maxSize]
+//        aisdiLinear [options] memory [maxSize]
+//        aisdiLinear [options] latency [count]
+//        aisdiLinear [options] fragmentation [size]
+//        aisdiLinear [options] prefetch [size]
+//        aisdiLinear [options] mpsc [itemsPerProducer]
+//        aisdiLinear [options] concurrent [count]
+//        aisdiLinear [options] snapshots [size]
+//        aisdiLinear [options] readmostly [size]
+//        aisdiLinear [options] persistent [size]
+//        aisdiLinear [options] cache [maxBytes]
+//        aisdiLinear [options] crossover [maxSize [table.h]]
+//                             writes the crossovers found as a CrossoverTable.h
+//                             for SequenceSelection.h (to table.h if given)
+// Options: --counters         count hardware events where permitted
+//          --format=json|csv  print results in a machine-readable format
+//                             (see aisdiCompare) instead of tables
+int main(int argc, char** argv)
+{
+    std::vector<std::string> arguments;
+    BenchmarkSettings settings;
+    std::string format = "text";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        if (argument == "--counters")
+            settings.hardwareCounters = true;
+        else if (argument.compare(0, 9, "--format=") == 0)
+            format = argument.substr(9);
+        else
+            arguments.push_back(argument);
+    }
+
+    if (format != "text" && format != "json" && format != "csv")
+    {
+        std::cerr << "unknown format: " << format << '\n';
+        return 2;
+    }
+
+    if (format != "text")
+        tables.rdbuf(nullptr);
+
+    if (settings.hardwareCounters)
+        std::cerr << "hardware counters: " << Benchmark::hardwareCountersStatus() << '\n';
+
+    benchmark = Benchmark(settings);
+    results.metadata = BenchmarkMetadata::current();
+
+    runSuite(arguments);
+
+    if (format == "json")
+        results.writeJson(cout);
+    else if (format == "csv")
+        results.writeCsv(cout);
+
     return 0;
-}
\ No newline at end of file
+}
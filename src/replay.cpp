@@ -0,0 +1,139 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "Vector.h"
+#include "LinkedList.h"
+#include "Deque.h"
+#include "TieredVector.h"
+#include "BTreeSequence.h"
+#include "ContainerAdapters.h"
+#include "Benchmark.h"
+#include "OperationTrace.h"
+
+using namespace aisdi;
+
+namespace
+{
+
+    struct IndexedList : LinkedList<long long>
+    {
+        IndexedList()
+        {
+            enableIndex();
+        }
+    };
+
+    // Records a mixed workload from a live Vector, as a stand-in for a
+    // production capture.
+    void recordSyntheticTrace(const std::string &path, std::size_t operations)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            throw std::runtime_error("cannot create " + path);
+
+        TraceWriter writer(out);
+        RecordingCollection<Vector<long long>> collection(writer);
+        std::mt19937_64 random(operations);
+
+        for (std::size_t i = 0; i < operations; i++)
+        {
+            const std::size_t size = collection.getSize();
+            const unsigned kind = random() % 100;
+            const long long value = static_cast<long long>(random() % 1000000);
+
+            if (kind < 40 || size == 0)
+                collection.append(value);
+            else if (kind < 50)
+                collection.prepend(value);
+            else if (kind < 62)
+                collection.insert(collection.begin() + random() % (size + 1), value);
+            else if (kind < 72)
+                collection.erase(collection.begin() + random() % size);
+            else if (kind < 80)
+                collection.popFirst();
+            else if (kind < 99)
+                collection.recordRead(random() % size);
+            else
+                collection.recordIteration();
+        }
+
+        std::cout << "recorded " << writer.getRecordCount() << " operations to " << path << '\n';
+    }
+
+    template<typename Collection>
+    void replay(const Benchmark &benchmark, const std::string &label, const std::string &path,
+                const MappedTrace &mapped)
+    {
+        std::size_t mismatches = 0;
+
+        BenchmarkStatistics statistics = benchmark.run([&]() {
+            Collection collection;
+            TraceReplayer<Collection> replayer(collection);
+            mapped.forEach([&replayer](const TraceRecord &record) { replayer(record); });
+            doNotOptimize(replayer.getChecksum());
+            mismatches = replayer.getMismatches();
+        }, mapped.size());
+        Benchmark::printRow(std::cout, label + " mmap", statistics,
+                            mismatches ? std::to_string(mismatches) + " clamped" : "");
+
+        statistics = benchmark.run([&]() {
+            std::ifstream in(path, std::ios::binary);
+            TraceStreamReader reader(in);
+            Collection collection;
+            TraceReplayer<Collection> replayer(collection);
+            reader.forEach([&replayer](const TraceRecord &record) { replayer(record); });
+            doNotOptimize(replayer.getChecksum());
+        }, mapped.size());
+        Benchmark::printRow(std::cout, label + " stream", statistics);
+    }
+
+}
+
+// Usage: aisdiReplay <trace>
+//        aisdiReplay record <trace> [operations]
+// Replays a trace against every container, both from a memory mapping and
+// streamed from the file, and reports throughput in operations per second.
+// "record" writes a synthetic trace, captured with RecordingCollection.
+int main(int argc, char** argv)
+{
+    try
+    {
+        if (argc > 2 && std::string(argv[1]) == "record")
+        {
+            recordSyntheticTrace(argv[2], argc > 3 ? std::atoll(argv[3]) : 100000);
+            return 0;
+        }
+
+        if (argc != 2)
+        {
+            std::cerr << "usage: " << argv[0] << " <trace>\n"
+                      << "       " << argv[0] << " record <trace> [operations]\n";
+            return 2;
+        }
+
+        const std::string path = argv[1];
+        MappedTrace mapped(path);
+        const Benchmark benchmark;
+
+        Benchmark::printHeader(std::cout, "replay of " + std::to_string(mapped.size()) + " operations from " + path);
+        replay<StdVector<long long>>(benchmark, "std::vector", path, mapped);
+        replay<StdList<long long>>(benchmark, "std::list", path, mapped);
+        replay<StdDeque<long long>>(benchmark, "std::deque", path, mapped);
+        replay<Vector<long long>>(benchmark, "vector", path, mapped);
+        replay<LinkedList<long long>>(benchmark, "list", path, mapped);
+        replay<IndexedList>(benchmark, "indexed list", path, mapped);
+        replay<Deque<long long>>(benchmark, "deque", path, mapped);
+        replay<TieredVector<long long>>(benchmark, "tiered vector", path, mapped);
+        replay<BTreeSequence<long long>>(benchmark, "b+tree", path, mapped);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <ConcurrentVector.h>
+#include <OperationCountingObject.h>
+
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using aisdi::OperationCountingObject;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+        std::uint64_t,
+        std::complex<std::int32_t>,
+        OperationCountingObject>;
+
+BOOST_AUTO_TEST_SUITE(ConcurrentVectorTests)
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreated_ThenItIsEmpty,
+                                  T,
+                                  TestedTypes)
+    {
+        const aisdi::ConcurrentVector<T> collection;
+
+        BOOST_CHECK(collection.isEmpty());
+        BOOST_CHECK_EQUAL(collection.getSize(), 0);
+        BOOST_CHECK(!collection.isReady(0));
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppending_ThenIndicesFollowAndItemsAreKept,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::ConcurrentVector<T> collection;
+
+        for (int i = 0; i < 1000; ++i)
+            BOOST_REQUIRE_EQUAL(collection.append(T(i)), static_cast<std::size_t>(i));
+
+        BOOST_CHECK_EQUAL(collection.getSize(), 1000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            BOOST_REQUIRE(collection.isReady(i));
+            BOOST_REQUIRE(collection[i] == T(i));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenGrowing_ThenElementAddressesDoNotChange,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::ConcurrentVector<T> collection;
+        std::vector<const T *> addresses;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            collection.append(T(i));
+            addresses.push_back(&collection[i]);
+        }
+
+        for (int i = 100; i < 10000; ++i)
+            collection.append(T(i));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            BOOST_REQUIRE_EQUAL(&collection[i], addresses[i]);
+            BOOST_REQUIRE(*addresses[i] == T(i));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAccessingPastTheEnd_ThenOperationThrows,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::ConcurrentVector<T> collection;
+        collection.reserve(100);
+        collection.append(T(1));
+
+        BOOST_CHECK(collection.at(0) == T(1));
+        BOOST_CHECK_THROW(collection.at(1), std::out_of_range);
+        BOOST_CHECK_THROW(collection.at(5000), std::out_of_range);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenCollection_WhenDestroyed_ThenAllItemsAreDestroyed)
+    {
+        OperationCountingObject::resetCounters();
+        {
+            aisdi::ConcurrentVector<OperationCountingObject> collection;
+            for (int i = 0; i < 500; ++i)
+                collection.append(OperationCountingObject(i));
+        }
+
+        BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(),
+                          OperationCountingObject::destroyedObjectsCount());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenManyThreads_WhenAppending_ThenEveryItemIsStoredOnce)
+    {
+        const int threadCount = 4;
+        const int itemsPerThread = 20000;
+
+        aisdi::ConcurrentVector<std::uint64_t> collection;
+        std::vector<std::thread> threads;
+        // Boost.Test assertions are not thread-safe.
+        std::atomic<int> misread(0);
+
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&collection, &misread, t, itemsPerThread]() {
+                for (int i = 0; i < itemsPerThread; ++i)
+                {
+                    std::uint64_t item = static_cast<std::uint64_t>(t) * itemsPerThread + i;
+                    std::size_t index = collection.append(item);
+                    if (collection[index] != item)
+                        misread++;
+                }
+            });
+        }
+
+        for (std::thread &thread : threads)
+            thread.join();
+
+        BOOST_CHECK_EQUAL(misread.load(), 0);
+        BOOST_REQUIRE_EQUAL(collection.getSize(), threadCount * itemsPerThread);
+        std::vector<bool> seen(threadCount * itemsPerThread);
+        for (std::size_t i = 0; i < collection.getSize(); ++i)
+        {
+            BOOST_REQUIRE(collection.isReady(i));
+            BOOST_REQUIRE(!seen[collection[i]]);
+            seen[collection[i]] = true;
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
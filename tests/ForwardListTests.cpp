@@ -0,0 +1,287 @@
+#include <ForwardList.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedCollections = boost::mpl::list<aisdi::ForwardList<std::int32_t>,
+        aisdi::ForwardList<std::uint64_t>,
+        aisdi::ForwardList<std::complex<std::int32_t>>,
+        aisdi::ForwardList<std::int32_t, true>,
+        aisdi::ForwardList<std::complex<std::int32_t>, true>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(ForwardListTests)
+
+    template<typename Collection>
+    void thenCollectionContainsValues(const Collection &collection,
+                                      std::initializer_list<int> expected)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                      begin(expected), end(expected));
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                                  Collection,
+                                  TestedCollections)
+    {
+        const Collection collection;
+
+        BOOST_CHECK(collection.isEmpty());
+        BOOST_CHECK(collection.begin() == collection.end());
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenInitializingFromList_ThenAllItemsAreInCollection,
+                                  Collection,
+                                  TestedCollections)
+    {
+        const Collection collection = {1410, 753, 1789};
+
+        thenCollectionContainsValues(collection, {1410, 753, 1789});
+        BOOST_CHECK_EQUAL(collection.getSize(), 3);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppendingItem_ThenItemIsLast,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {1, 2};
+
+        collection.append(3);
+
+        thenCollectionContainsValues(collection, {1, 2, 3});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPrependingItem_ThenItemIsFirst,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {1, 2};
+
+        collection.prepend(0);
+
+        thenCollectionContainsValues(collection, {0, 1, 2});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPrependingThenAppending_ThenTailIsTracked,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection;
+
+        collection.prepend(2);
+        collection.append(3);
+        collection.prepend(1);
+
+        thenCollectionContainsValues(collection, {1, 2, 3});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingFirst_ThenOperationThrows,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection;
+
+        BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenItemIsReturnedAndRemoved,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {101, 202, 303};
+
+        BOOST_CHECK_EQUAL(collection.popFirst(), 101);
+        thenCollectionContainsValues(collection, {202, 303});
+        BOOST_CHECK_EQUAL(collection.getSize(), 2);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSingleItem_WhenPoppingFirstThenAppending_ThenItemIsAppended,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {7};
+
+        collection.popFirst();
+        collection.append(8);
+        collection.append(9);
+
+        thenCollectionContainsValues(collection, {8, 9});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenUsedAsQueue_ThenItemsComeOutInOrder,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            collection.append(2 * i);
+            collection.append(2 * i + 1);
+            BOOST_CHECK_EQUAL(collection.popFirst(), i);
+        }
+
+        BOOST_CHECK_EQUAL(collection.getSize(), 100);
+        BOOST_CHECK_EQUAL(collection.popFirst(), 100);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBeforeBeginIterator_WhenInsertingAfter_ThenItemIsPrepended,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {2, 3};
+
+        auto it = collection.insertAfter(collection.beforeBegin(), 1);
+
+        BOOST_CHECK_EQUAL(*it, 1);
+        thenCollectionContainsValues(collection, {1, 2, 3});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLastItemIterator_WhenInsertingAfter_ThenItemIsAppended,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {1, 2};
+
+        collection.insertAfter(begin(collection) + 1, 3);
+        collection.append(4);
+
+        thenCollectionContainsValues(collection, {1, 2, 3, 4});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenInsertingAfter_ThenOperationThrows,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {1, 2};
+
+        BOOST_CHECK_THROW(collection.insertAfter(end(collection), 3), std::out_of_range);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingAfterMiddleItem_ThenNextItemIsRemoved,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {22, 51, 48};
+
+        auto it = collection.eraseAfter(begin(collection));
+
+        BOOST_CHECK_EQUAL(*it, 48);
+        thenCollectionContainsValues(collection, {22, 48});
+        BOOST_CHECK_EQUAL(collection.getSize(), 2);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingLastItem_ThenTailIsUpdated,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {22, 45, 33};
+
+        auto it = collection.eraseAfter(begin(collection) + 1);
+        collection.append(60);
+
+        BOOST_CHECK(it == end(collection));
+        thenCollectionContainsValues(collection, {22, 45, 60});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLastItemIterator_WhenErasingAfter_ThenOperationThrows,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {20, 16};
+
+        BOOST_CHECK_THROW(collection.eraseAfter(begin(collection) + 1), std::out_of_range);
+        BOOST_CHECK_THROW(collection.eraseAfter(end(collection)), std::out_of_range);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenIncrementingOrDereferencing_ThenOperationThrows,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection;
+
+        BOOST_CHECK_THROW(collection.end()++, std::out_of_range);
+        BOOST_CHECK_THROW(++(collection.cend()), std::out_of_range);
+        BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
+        BOOST_CHECK_THROW(*collection.beforeBegin(), std::out_of_range);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenDereferencing_ThenItemCanBeChanged,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {10, 20, 30};
+
+        auto it = ++begin(collection);
+        *it = 500;
+
+        thenCollectionContainsValues(collection, {10, 500, 30});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenCreatingCopy_ThenAllItemsAreCopied,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {1410, 753, 1789};
+        Collection other{collection};
+
+        collection.append(1);
+        other.append(2);
+
+        thenCollectionContainsValues(collection, {1410, 753, 1789, 1});
+        thenCollectionContainsValues(other, {1410, 753, 1789, 2});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMovingToOther_ThenAllItemsAreMoved,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {1410, 753, 1789};
+        Collection other{std::move(collection)};
+
+        other.append(1);
+        collection.append(2);
+
+        thenCollectionContainsValues(other, {1410, 753, 1789, 1});
+        thenCollectionContainsValues(collection, {2});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenAssigningToOther_ThenAllElementsAreCopied,
+                                  Collection,
+                                  TestedCollections)
+    {
+        const Collection collection = {1, 2, 3, 4};
+        Collection other = {100, 200, 300, 400};
+
+        other = collection;
+        other = other;
+
+        thenCollectionContainsValues(other, {1, 2, 3, 4});
+        thenCollectionContainsValues(collection, {1, 2, 3, 4});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMoveAssigning_ThenAllElementsAreMoved,
+                                  Collection,
+                                  TestedCollections)
+    {
+        Collection collection = {1, 2, 3, 4};
+        Collection other = {100, 200, 300, 400};
+
+        other = std::move(collection);
+        other.popFirst();
+        other.append(5);
+
+        thenCollectionContainsValues(other, {2, 3, 4, 5});
+        BOOST_CHECK(collection.isEmpty());
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,120 +1,101 @@
 #include <LinkedList.h>
+#include <PrefetchWalk.h>
+#include <OperationCountingObject.h>
 
+#include "ReferenceModel.h"
+
+#include <algorithm>
 #include <initializer_list>
 #include <complex>
 #include <cstdint>
 #include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 
 #include <boost/mpl/list.hpp>
 
+// Test hooks in the global allocator, for compact()'s 64 KiB slabs.
 namespace
 {
 
-    class OperationCountingObject
-    {
-    public:
-        OperationCountingObject(int value_ = 0)
-                : value(value_)
-        {
-            ++constructedObjects;
-        }
-
-        OperationCountingObject(const OperationCountingObject &other)
-                : value(std::move(other.value))
-        {
-            ++constructedObjects;
-            ++copiedObjects;
-        }
+    const std::size_t LARGE_ALLOCATION = 64 * 1024;
 
-        OperationCountingObject(OperationCountingObject &&other)
-                : value(other.value)
-        {
-            ++constructedObjects;
-            ++movedObjects;
-        }
+    // When non-zero, the large allocation that brings it to zero throws.
+    std::size_t largeAllocationsUntilFailure = 0;
 
-        ~OperationCountingObject()
-        {
-            ++destroyedObjects;
-        }
+    // While set, the next large block freed is kept and carved into the
+    // following allocations, as malloc reuses freed memory. Anything still
+    // holding on to the block then sees its memory change hands; the
+    // allocations carved from it must all be freed again.
+    bool reuseFreedLargeBlock = false;
+    char *largeBlocks[16];
+    std::size_t largeBlockCount = 0;
+    char *reused = nullptr;
+    std::size_t reusedBytes = 0;
+    std::size_t liveInReused = 0;
 
-        OperationCountingObject &operator=(const OperationCountingObject &other)
-        {
-            ++assignedObjects;
-            value = other.value;
-            return *this;
-        }
+    bool isReused(void *memory)
+    {
+        return reused != nullptr && memory >= reused && memory < reused + LARGE_ALLOCATION;
+    }
 
-        OperationCountingObject &operator=(OperationCountingObject &&other)
-        {
-            ++assignedObjects;
-            ++movedObjects;
-            value = std::move(other.value);
-            return *this;
-        }
+} // namespace
 
-        operator int() const
-        {
-            return value;
-        }
+void *operator new(std::size_t size)
+{
+    if (size >= LARGE_ALLOCATION && largeAllocationsUntilFailure > 0 && --largeAllocationsUntilFailure == 0)
+        throw std::bad_alloc();
 
-        static void resetCounters()
-        {
-            constructedObjects = 0;
-            destroyedObjects = 0;
-            copiedObjects = 0;
-            movedObjects = 0;
-            assignedObjects = 0;
-        }
+    std::size_t aligned = (size + 15) / 16 * 16;
+    if (reuseFreedLargeBlock && reused != nullptr && reusedBytes + aligned <= LARGE_ALLOCATION)
+    {
+        liveInReused++;
+        reusedBytes += aligned;
+        return reused + reusedBytes - aligned;
+    }
 
-        static std::size_t constructedObjectsCount()
-        {
-            return constructedObjects;
-        }
+    void *memory = std::malloc(size > 0 ? size : 1);
+    if (memory == nullptr)
+        throw std::bad_alloc();
 
-        static std::size_t destroyedObjectsCount()
-        {
-            return destroyedObjects;
-        }
+    if (size >= LARGE_ALLOCATION)
+        largeBlocks[largeBlockCount++ % 16] = static_cast<char*>(memory);
 
-        static std::size_t copiedObjectsCount()
-        {
-            return copiedObjects;
-        }
+    return memory;
+}
 
-        static std::size_t movedObjectsCount()
-        {
-            return movedObjects;
-        }
+void operator delete(void *memory) noexcept
+{
+    if (isReused(memory))
+    {
+        liveInReused--;
+        return;
+    }
 
-        static std::size_t assignedObjectsCount()
-        {
-            return assignedObjects;
-        }
+    if (reuseFreedLargeBlock && reused == nullptr && memory != nullptr
+        && std::find(largeBlocks, largeBlocks + 16, memory) != largeBlocks + 16)
+    {
+        reused = static_cast<char*>(memory);
+        return;
+    }
 
-    private:
-        int value;
+    std::free(memory);
+}
 
-        static std::size_t constructedObjects;
-        static std::size_t destroyedObjects;
-        static std::size_t copiedObjects;
-        static std::size_t movedObjects;
-        static std::size_t assignedObjects;
-    };
+void operator delete(void *memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
 
-    std::size_t OperationCountingObject::constructedObjects = 0;
-    std::size_t OperationCountingObject::destroyedObjects = 0;
-    std::size_t OperationCountingObject::copiedObjects = 0;
-    std::size_t OperationCountingObject::movedObjects = 0;
-    std::size_t OperationCountingObject::assignedObjects = 0;
+namespace
+{
 
-    std::ostream &operator<<(std::ostream &out, const OperationCountingObject &obj)
-    {
-        return out << '<' << static_cast<int>(obj) << '>';
-    }
+    using aisdi::OperationCountingObject;
 
     struct Fixture
     {
@@ -124,6 +105,30 @@ namespace
         }
     };
 
+    struct ChainNode
+    {
+        int value;
+        ChainNode *next;
+    };
+
+    const int PREFETCHED = 100;
+
+    // Walks a chain of count nodes and logs, in order, the value of every
+    // visited node and PREFETCHED plus the value of every prefetched one.
+    std::vector<int> walkChain(int count, std::size_t distance)
+    {
+        std::vector<ChainNode> chain(count + 1);
+        for (int i = 0; i <= count; ++i)
+            chain[i] = {i, i < count ? &chain[i + 1] : nullptr};
+
+        std::vector<int> log;
+        aisdi::walkPrefetching(&chain[0], &chain[count], distance,
+                               [&log](ChainNode *node) { log.push_back(node->value); },
+                               [&log](const ChainNode *node) { log.push_back(PREFETCHED + node->value); });
+
+        return log;
+    }
+
 } // namespace
 
 template<typename T>
@@ -137,7 +142,9 @@ using TestedTypes = boost::mpl::list<std::int32_t,
 using std::begin;
 using std::end;
 
-BOOST_FIXTURE_TEST_SUITE(VectorTests, Fixture)
+using namespace reference_model;
+
+BOOST_FIXTURE_TEST_SUITE(LinkedListTests, Fixture)
 
     template<typename T>
     void thenCollectionContainsValues(const LinearCollection<T> &collection,
@@ -948,6 +955,421 @@ BOOST_FIXTURE_TEST_SUITE(VectorTests, Fixture)
         BOOST_CHECK_EQUAL(collection.getSize(), 2);
     }
 
+    // Also seeks to every 37th item, which goes through the index when
+    // one is enabled.
+    template<typename T>
+    void thenCollectionAndSeeksMatch(const LinearCollection<T> &collection, const std::vector<int> &expected)
+    {
+        thenCollectionMatches(collection, expected);
+        for (std::size_t i = 0; i < expected.size(); i += 37)
+            BOOST_REQUIRE_EQUAL(*(begin(collection) + i), expected[i]);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenEnablingIndex_ThenItemsAreKept,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        std::vector<int> expected;
+
+        for (int i = 0; i < 500; ++i)
+        {
+            collection.append(i);
+            expected.push_back(i);
+        }
+
+        collection.enableIndex();
+
+        BOOST_CHECK(collection.isIndexed());
+        thenCollectionAndSeeksMatch(collection, expected);
+        BOOST_CHECK(end(collection) - 500 == begin(collection));
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIndexedCollection_WhenInsertingAndErasingAtRandom_ThenSeeksMatchReference,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        collection.enableIndex();
+        std::vector<int> expected;
+        std::mt19937 random(1920);
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            std::size_t index = random() % (expected.size() + 1);
+            switch (random() % 8)
+            {
+                case 0:
+                    collection.prepend(i);
+                    expected.insert(expected.begin(), i);
+                    break;
+                case 1:
+                    collection.append(i);
+                    expected.push_back(i);
+                    break;
+                case 2:
+                    if (!expected.empty())
+                    {
+                        BOOST_REQUIRE_EQUAL(collection.popLast(), expected.back());
+                        expected.pop_back();
+                    }
+                    break;
+                case 3:
+                    if (index < expected.size())
+                    {
+                        BOOST_REQUIRE_EQUAL(*(begin(collection) + index), expected[index]);
+                        collection.erase(begin(collection) + index);
+                        expected.erase(expected.begin() + index);
+                    }
+                    break;
+                case 4:
+                    if (index < expected.size())
+                    {
+                        std::size_t last = index + random() % (expected.size() - index + 1) / 4;
+                        collection.erase(begin(collection) + index, begin(collection) + last);
+                        expected.erase(expected.begin() + index, expected.begin() + last);
+                    }
+                    break;
+                default:
+                    collection.insert(begin(collection) + index, i);
+                    expected.insert(expected.begin() + index, i);
+            }
+        }
+
+        thenCollectionAndSeeksMatch(collection, expected);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIndexedCollection_WhenCopyingAndMoving_ThenIndexFollows,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        collection.enableIndex();
+        std::vector<int> expected;
+
+        for (int i = 0; i < 400; ++i)
+        {
+            collection.append(i);
+            expected.push_back(i);
+        }
+
+        LinearCollection<T> copy{collection};
+        LinearCollection<T> moved{std::move(collection)};
+        moved.insert(begin(moved) + 200, -1);
+        expected.insert(expected.begin() + 200, -1);
+
+        BOOST_CHECK(copy.isIndexed());
+        BOOST_CHECK(moved.isIndexed());
+        thenCollectionAndSeeksMatch(moved, expected);
+        BOOST_CHECK_EQUAL(*(end(copy) - 100), 300);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIndexedCollection_WhenDisablingIndex_ThenSeeksStillWork,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        collection.enableIndex();
+
+        for (int i = 0; i < 100; ++i)
+            collection.append(i);
+
+        collection.disableIndex();
+        collection.insert(begin(collection) + 50, -1);
+
+        BOOST_CHECK(!collection.isIndexed());
+        BOOST_CHECK_EQUAL(*(begin(collection) + 50), -1);
+        BOOST_CHECK_EQUAL(*(begin(collection) + 51), 50);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenScatteredCollection_WhenCompacting_ThenItemsAreKeptBackToBack,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        std::vector<int> expected;
+        std::mt19937 random(43);
+
+        for (int i = 0; i < 500; ++i)
+        {
+            std::size_t index = random() % (expected.size() + 1);
+            collection.insert(begin(collection) + index, i);
+            expected.insert(expected.begin() + index, i);
+        }
+
+        collection.compact();
+
+        thenCollectionAndSeeksMatch(collection, expected);
+        for (auto it = begin(collection); it + 1 != end(collection); ++it)
+            BOOST_REQUIRE(&*it < &*(it + 1));
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCompactedCollection_WhenModifying_ThenItemsMatchReference,
+                                  T,
+                                  TestedTypes)
+    {
+        {
+            LinearCollection<T> collection;
+            std::vector<int> expected;
+            std::mt19937 random(44);
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                collection.append(i);
+                expected.push_back(i);
+            }
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                if (i % 500 == 0)
+                    collection.compact();
+
+                std::size_t index = random() % (expected.size() + 1);
+                switch (random() % 4)
+                {
+                    case 0:
+                        if (!expected.empty())
+                        {
+                            BOOST_REQUIRE_EQUAL(collection.popFirst(), expected.front());
+                            expected.erase(expected.begin());
+                        }
+                        break;
+                    case 1:
+                        if (index < expected.size())
+                        {
+                            collection.erase(begin(collection) + index);
+                            expected.erase(expected.begin() + index);
+                        }
+                        break;
+                    case 2:
+                        if (index < expected.size())
+                        {
+                            std::size_t last = std::min(expected.size(), index + 1 + random() % 5);
+                            collection.erase(begin(collection) + index, begin(collection) + last);
+                            expected.erase(expected.begin() + index, expected.begin() + last);
+                        }
+                        break;
+                    default:
+                        collection.insert(begin(collection) + index, -i);
+                        expected.insert(expected.begin() + index, -i);
+                }
+            }
+
+            thenCollectionAndSeeksMatch(collection, expected);
+        }
+
+        thenDestroyedObjectsCountWas<T>(OperationCountingObject::constructedObjectsCount());
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIndexedCollection_WhenCompacting_ThenSeeksStillWork,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        collection.enableIndex();
+        std::vector<int> expected;
+
+        for (int i = 0; i < 400; ++i)
+        {
+            collection.prepend(i);
+            expected.insert(expected.begin(), i);
+        }
+
+        collection.compact();
+        collection.insert(begin(collection) + 200, -1);
+        expected.insert(expected.begin() + 200, -1);
+        collection.erase(end(collection) - 100);
+        expected.erase(expected.end() - 100);
+
+        BOOST_CHECK(collection.isIndexed());
+        thenCollectionAndSeeksMatch(collection, expected);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSlabAllocationFailing_WhenCompacting_ThenItemsAreKeptAndSlabIsForgotten,
+                                  T,
+                                  TestedTypes)
+    {
+        {
+            LinearCollection<T> collection;
+            std::vector<int> expected;
+            for (int i = 0; i < 10000; ++i)
+            {
+                collection.append(i);
+                expected.push_back(i);
+            }
+
+            largeAllocationsUntilFailure = 2;
+            BOOST_CHECK_THROW(collection.compact(), std::bad_alloc);
+            largeAllocationsUntilFailure = 0;
+            thenCollectionMatches(collection, expected);
+
+            // Frees the one filled slab, whose memory then goes to the
+            // nodes appended next.
+            reuseFreedLargeBlock = true;
+            eraseAt(collection, expected, 0, expected.size());
+            for (int i = 0; i < 3000; ++i)
+            {
+                collection.append(i);
+                expected.push_back(i);
+            }
+            reuseFreedLargeBlock = false;
+
+            collection.compact();
+            eraseAt(collection, expected, 100, 2000);
+            thenCollectionMatches(collection, expected);
+        }
+
+        BOOST_CHECK(reused != nullptr);
+        BOOST_CHECK_EQUAL(liveInReused, 0);
+        std::free(reused);
+        reused = nullptr;
+        reusedBytes = 0;
+        liveInReused = 0;
+
+        BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(),
+                          OperationCountingObject::destroyedObjectsCount());
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCompactedCollection_WhenMovingAndAssigning_ThenItemsFollow,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        for (int i = 0; i < 300; ++i)
+            collection.append(i);
+
+        collection.compact();
+        LinearCollection<T> moved{std::move(collection)};
+        moved.erase(begin(moved), begin(moved) + 100);
+
+        LinearCollection<T> assigned = {1, 2, 3};
+        assigned.compact();
+        assigned = std::move(moved);
+
+        BOOST_CHECK(collection.isEmpty());
+        BOOST_CHECK_EQUAL(assigned.getSize(), 200);
+        BOOST_CHECK_EQUAL(*begin(assigned), 100);
+        BOOST_CHECK_EQUAL(*(end(assigned) - 1), 299);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNewCollection_WhenCheckingPrefetchDistance_ThenPrefetchingIsOff,
+                                  T,
+                                  TestedTypes)
+    {
+        const LinearCollection<T> collection = {1, 2, 3};
+
+        BOOST_CHECK_EQUAL(collection.getPrefetchDistance(), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCallingForEach_ThenItemsAreVisitedInOrder,
+                                  T,
+                                  TestedTypes)
+    {
+        for (std::size_t distance : {0, 1, 8})
+        {
+            LinearCollection<T> collection = {1, 2, 3, 4, 5};
+            collection.setPrefetchDistance(distance);
+            std::vector<T> visited;
+
+            collection.forEach([&visited](T &item) {
+                visited.push_back(item);
+                item = T(item * 10);
+            });
+
+            BOOST_CHECK_EQUAL(collection.getPrefetchDistance(), distance);
+            BOOST_CHECK(visited == std::vector<T>({1, 2, 3, 4, 5}));
+            thenCollectionContainsValues(collection, {10, 20, 30, 40, 50});
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenAnyPrefetchDistance_WhenCopyingAndErasing_ThenItemsAreKept,
+                                  T,
+                                  TestedTypes)
+    {
+        for (std::size_t distance : {0, 1, 2, 1000})
+        {
+            LinearCollection<T> collection;
+            collection.setPrefetchDistance(distance);
+            std::vector<int> expected;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                collection.append(i);
+                expected.push_back(i);
+            }
+
+            LinearCollection<T> copy{collection};
+            copy.erase(begin(copy) + 10, begin(copy) + 20);
+            expected.erase(expected.begin() + 10, expected.begin() + 20);
+
+            BOOST_CHECK_EQUAL(copy.getPrefetchDistance(), distance);
+            thenCollectionAndSeeksMatch(copy, expected);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollections_WhenCopyingMovingAndAssigning_ThenSourceSettingsAreTaken,
+                                  T,
+                                  TestedTypes)
+    {
+        for (bool indexed : {false, true})
+        {
+            LinearCollection<T> collection = {1, 2, 3};
+            collection.setPrefetchDistance(3);
+            if (indexed)
+                collection.enableIndex();
+
+            // Targets start with the opposite settings, so keeping them shows.
+            LinearCollection<T> assigned = {4};
+            LinearCollection<T> moveAssigned = {5};
+            for (LinearCollection<T> *target : {&assigned, &moveAssigned})
+            {
+                target->setPrefetchDistance(7);
+                if (!indexed)
+                    target->enableIndex();
+            }
+
+            LinearCollection<T> copy{collection};
+            assigned = collection;
+            LinearCollection<T> source{collection};
+            moveAssigned = std::move(source);
+            LinearCollection<T> moved{std::move(collection)};
+
+            for (const LinearCollection<T> *result : {&copy, &assigned, &moveAssigned, &moved})
+            {
+                BOOST_CHECK_EQUAL(result->isIndexed(), indexed);
+                BOOST_CHECK_EQUAL(result->getPrefetchDistance(), 3);
+                thenCollectionAndSeeksMatch(*result, {1, 2, 3});
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenZeroDistance_WhenWalkingNodes_ThenNothingIsPrefetched)
+    {
+        BOOST_CHECK(walkChain(4, 0) == std::vector<int>({0, 1, 2, 3}));
+        BOOST_CHECK(walkChain(0, 0).empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenDistance_WhenWalkingNodes_ThenNodesThatFarAheadArePrefetched)
+    {
+        BOOST_CHECK(walkChain(4, 1) == std::vector<int>({101, 102, 0, 103, 1, 104, 2, 3}));
+        BOOST_CHECK(walkChain(4, 2) == std::vector<int>({101, 102, 103, 0, 104, 1, 2, 3}));
+        BOOST_CHECK(walkChain(4, 100) == std::vector<int>({101, 102, 103, 104, 0, 1, 2, 3}));
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenWalkThatDestroysNodes_WhenWalking_ThenSuccessorIsReadFirst)
+    {
+        std::vector<int> visited;
+        ChainNode *first = nullptr;
+        for (int i = 3; i >= 0; --i)
+            first = new ChainNode{i, first};
+
+        aisdi::walkPrefetching(first, static_cast<ChainNode*>(nullptr), 0,
+                               [&visited](ChainNode *node) { visited.push_back(node->value); delete node; },
+                               [](const ChainNode *) {});
+
+        BOOST_CHECK(visited == std::vector<int>({0, 1, 2, 3}));
+    }
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
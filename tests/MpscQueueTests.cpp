@@ -0,0 +1,154 @@
+#include <MpscQueue.h>
+#include <OperationCountingObject.h>
+
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using aisdi::OperationCountingObject;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+        std::uint64_t,
+        std::complex<std::int32_t>,
+        OperationCountingObject>;
+
+BOOST_AUTO_TEST_SUITE(MpscQueueTests)
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyQueue_WhenPopping_ThenNothingIsReturned,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::MpscQueue<T> queue;
+        T item{};
+
+        BOOST_CHECK(queue.isEmpty());
+        BOOST_CHECK(!queue.tryPop(item));
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenQueue_WhenPushingAndPopping_ThenItemsComeOutInOrder,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::MpscQueue<T> queue;
+        typename aisdi::MpscQueue<T>::Producer &producer = queue.addProducer();
+        T item{};
+
+        queue.push(T(1));
+        producer.push(T(2));
+        queue.push(T(3));
+
+        BOOST_REQUIRE(queue.tryPop(item));
+        BOOST_CHECK(item == T(1));
+        BOOST_REQUIRE(queue.tryPop(item));
+        BOOST_CHECK(item == T(2));
+        producer.push(T(4));
+        BOOST_REQUIRE(queue.tryPop(item));
+        BOOST_CHECK(item == T(3));
+        BOOST_REQUIRE(queue.tryPop(item));
+        BOOST_CHECK(item == T(4));
+        BOOST_CHECK(!queue.tryPop(item));
+        BOOST_CHECK(queue.isEmpty());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenProducer_WhenPushingWithRecycledNodes_ThenItemsComeOutInOrder)
+    {
+        aisdi::MpscQueue<int> queue;
+        aisdi::MpscQueue<int>::Producer &producer = queue.addProducer();
+        int item = 0;
+
+        for (int i = 0; i < 4; ++i)
+            producer.push(i);
+        while (queue.tryPop(item))
+            ;
+
+        // Popped nodes, all but the last which is the new tail, went back.
+        for (int i = 0; i < 3; ++i)
+        {
+            producer.push(i);
+            BOOST_REQUIRE(queue.tryPop(item));
+            BOOST_CHECK_EQUAL(item, i);
+        }
+
+        BOOST_CHECK(queue.isEmpty());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenNonEmptyQueue_WhenDestroyed_ThenRemainingItemsAreDestroyed)
+    {
+        OperationCountingObject::resetCounters();
+        {
+            aisdi::MpscQueue<OperationCountingObject> queue;
+            aisdi::MpscQueue<OperationCountingObject>::Producer &producer = queue.addProducer();
+            OperationCountingObject item;
+
+            for (int i = 0; i < 10; ++i)
+            {
+                queue.push(i);
+                producer.push(i);
+            }
+
+            for (int i = 0; i < 5; ++i)
+                BOOST_REQUIRE(queue.tryPop(item));
+        }
+
+        BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(),
+                          OperationCountingObject::destroyedObjectsCount());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenManyProducerThreads_WhenConsuming_ThenEveryItemArrivesOnceInProducerOrder)
+    {
+        const int producerCount = 4;
+        const int itemsPerProducer = 20000;
+
+        aisdi::MpscQueue<std::uint64_t> queue;
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < producerCount; ++p)
+        {
+            threads.emplace_back([&queue, p, itemsPerProducer]() {
+                aisdi::MpscQueue<std::uint64_t>::Producer &producer = queue.addProducer();
+                for (int i = 0; i < itemsPerProducer; ++i)
+                {
+                    std::uint64_t item = static_cast<std::uint64_t>(p) << 32 | static_cast<std::uint64_t>(i);
+                    // Every other item without the producer, so both paths race.
+                    if (i % 2 == 0)
+                        producer.push(item);
+                    else
+                        queue.push(item);
+                }
+            });
+        }
+
+        std::vector<int> nextExpected(producerCount, 0);
+        int received = 0;
+        std::uint64_t item = 0;
+
+        while (received < producerCount * itemsPerProducer)
+        {
+            if (!queue.tryPop(item))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            int producer = static_cast<int>(item >> 32);
+            int index = static_cast<int>(item & 0xffffffffu);
+            BOOST_REQUIRE(producer < producerCount);
+            BOOST_REQUIRE_EQUAL(index, nextExpected[producer]);
+            nextExpected[producer]++;
+            received++;
+        }
+
+        for (std::thread &thread : threads)
+            thread.join();
+
+        BOOST_CHECK(queue.isEmpty());
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
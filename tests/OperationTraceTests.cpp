@@ -0,0 +1,302 @@
+#include <OperationTrace.h>
+#include <Vector.h>
+#include <LinkedList.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <unistd.h>
+
+using aisdi::MappedTrace;
+using aisdi::RecordingCollection;
+using aisdi::TraceHeader;
+using aisdi::TraceOperation;
+using aisdi::TraceRecord;
+using aisdi::TraceReplayer;
+using aisdi::TraceStreamReader;
+using aisdi::TraceWriter;
+
+namespace
+{
+
+    std::vector<TraceRecord> sampleRecords()
+    {
+        return {TraceRecord::make(TraceOperation::APPEND, 0, 7),
+                TraceRecord::make(TraceOperation::PREPEND, 0, -3),
+                TraceRecord::make(TraceOperation::INSERT, 1, 1LL << 40),
+                TraceRecord::make(TraceOperation::ERASE_RANGE, 0, 2),
+                TraceRecord::make(TraceOperation::READ, 0),
+                TraceRecord::make(TraceOperation::POP_LAST)};
+    }
+
+    std::string writeTrace(const std::vector<TraceRecord> &records)
+    {
+        std::ostringstream out;
+        TraceWriter writer(out);
+        for (const TraceRecord &record : records)
+            writer.write(record);
+
+        BOOST_CHECK_EQUAL(writer.getRecordCount(), records.size());
+        return out.str();
+    }
+
+    std::vector<TraceRecord> readStream(const std::string &bytes)
+    {
+        std::istringstream in(bytes);
+        TraceStreamReader reader(in);
+        std::vector<TraceRecord> records;
+
+        std::size_t count = reader.forEach([&records](const TraceRecord &record) {
+            records.push_back(record);
+        });
+
+        BOOST_CHECK_EQUAL(count, records.size());
+        return records;
+    }
+
+    // Trace bytes in a file for MappedTrace, removed with the object.
+    struct TraceFile
+    {
+        std::string path;
+
+        explicit TraceFile(const std::string &bytes)
+        {
+            char name[] = "/tmp/aisdiTraceXXXXXX";
+            int descriptor = mkstemp(name);
+            BOOST_REQUIRE(descriptor >= 0);
+            BOOST_REQUIRE_EQUAL(write(descriptor, bytes.data(), bytes.size()),
+                                static_cast<ssize_t>(bytes.size()));
+            close(descriptor);
+            path = name;
+        }
+
+        ~TraceFile()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+    std::vector<TraceRecord> readMapped(const std::string &bytes)
+    {
+        TraceFile file(bytes);
+        MappedTrace trace(file.path);
+        std::vector<TraceRecord> records;
+
+        std::size_t count = trace.forEach([&records](const TraceRecord &record) {
+            records.push_back(record);
+        });
+
+        BOOST_CHECK_EQUAL(count, trace.size());
+        BOOST_CHECK_EQUAL(count, records.size());
+        return records;
+    }
+
+    void thenRecordsMatch(const std::vector<TraceRecord> &records, const std::vector<TraceRecord> &expected)
+    {
+        BOOST_REQUIRE_EQUAL(records.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            BOOST_CHECK(records[i].operation == expected[i].operation);
+            BOOST_CHECK_EQUAL(records[i].position, expected[i].position);
+            BOOST_CHECK_EQUAL(records[i].value, expected[i].value);
+        }
+    }
+
+    std::string traceWithHeader(const TraceHeader &header)
+    {
+        std::string bytes = writeTrace(sampleRecords());
+        bytes.replace(0, sizeof(header), reinterpret_cast<const char *>(&header), sizeof(header));
+        return bytes;
+    }
+
+    void thenBothReadersReject(const std::string &bytes)
+    {
+        std::istringstream in(bytes);
+        BOOST_CHECK_THROW(TraceStreamReader reader(in), std::runtime_error);
+
+        TraceFile file(bytes);
+        BOOST_CHECK_THROW(MappedTrace trace(file.path), std::runtime_error);
+    }
+
+    template<typename Collection>
+    std::vector<int> contentsOf(const Collection &collection)
+    {
+        return std::vector<int>(collection.begin(), collection.end());
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(OperationTraceTests)
+
+    BOOST_AUTO_TEST_CASE(GivenWrittenTrace_WhenReadingFromStream_ThenRecordsAreKept)
+    {
+        thenRecordsMatch(readStream(writeTrace(sampleRecords())), sampleRecords());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenWrittenTrace_WhenMapping_ThenRecordsAreKept)
+    {
+        thenRecordsMatch(readMapped(writeTrace(sampleRecords())), sampleRecords());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenTraceLongerThanOneChunk_WhenReadingFromStream_ThenAllRecordsAreRead)
+    {
+        std::vector<TraceRecord> records;
+        for (int i = 0; i < 10000; ++i)
+            records.push_back(TraceRecord::make(TraceOperation::INSERT, i, -i));
+
+        thenRecordsMatch(readStream(writeTrace(records)), records);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenEmptyTrace_WhenReading_ThenNoRecordsAreVisited)
+    {
+        BOOST_CHECK(readStream(writeTrace({})).empty());
+        BOOST_CHECK(readMapped(writeTrace({})).empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenBadMagic_WhenReading_ThenTraceIsRejected)
+    {
+        TraceHeader header = TraceHeader::current();
+        header.magic[0] = 'X';
+
+        thenBothReadersReject(traceWithHeader(header));
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenOtherVersion_WhenReading_ThenTraceIsRejected)
+    {
+        TraceHeader header = TraceHeader::current();
+        header.version = TraceHeader::VERSION + 1;
+
+        thenBothReadersReject(traceWithHeader(header));
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenForeignByteOrder_WhenReading_ThenTraceIsRejected)
+    {
+        TraceHeader header = TraceHeader::current();
+        header.byteOrder = 0x04030201;
+
+        thenBothReadersReject(traceWithHeader(header));
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenTruncatedHeader_WhenReading_ThenTraceIsRejected)
+    {
+        thenBothReadersReject(writeTrace({}).substr(0, sizeof(TraceHeader) - 1));
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenTruncatedLastRecord_WhenReading_ThenOnlyWholeRecordsAreVisited)
+    {
+        std::string bytes = writeTrace(sampleRecords());
+        bytes.resize(bytes.size() - sizeof(TraceRecord) / 2);
+
+        std::vector<TraceRecord> whole = sampleRecords();
+        whole.pop_back();
+        thenRecordsMatch(readStream(bytes), whole);
+        thenRecordsMatch(readMapped(bytes), whole);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenRecordingCollection_WhenCallsThrow_ThenOnlyCompletedCallsAreRecorded)
+    {
+        std::ostringstream out;
+        TraceWriter writer(out);
+        RecordingCollection<aisdi::Vector<int>> collection(writer);
+
+        BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+        BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+        collection.append(1);
+        collection.prepend(2);
+        collection.insert(collection.begin() + 1, 3);
+        BOOST_CHECK_THROW(collection.erase(collection.end()), std::out_of_range);
+        collection.erase(collection.begin());
+        BOOST_CHECK_EQUAL(collection.popLast(), 1);
+        collection.append(4);
+        collection.erase(collection.begin(), collection.begin() + 1);
+
+        thenRecordsMatch(readStream(out.str()),
+                         {TraceRecord::make(TraceOperation::APPEND, 0, 1),
+                          TraceRecord::make(TraceOperation::PREPEND, 0, 2),
+                          TraceRecord::make(TraceOperation::INSERT, 1, 3),
+                          TraceRecord::make(TraceOperation::ERASE, 0),
+                          TraceRecord::make(TraceOperation::POP_LAST),
+                          TraceRecord::make(TraceOperation::APPEND, 0, 4),
+                          TraceRecord::make(TraceOperation::ERASE_RANGE, 0, 1)});
+
+        aisdi::Vector<int> replayed;
+        TraceReplayer<aisdi::Vector<int>> replay(replayed);
+        for (const TraceRecord &record : readStream(out.str()))
+            replay(record);
+
+        BOOST_CHECK(contentsOf(replayed) == contentsOf(collection));
+        BOOST_CHECK_EQUAL(replay.getMismatches(), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenMatchingTrace_WhenReplaying_ThenOperationsAreApplied)
+    {
+        aisdi::Vector<int> collection;
+        TraceReplayer<aisdi::Vector<int>> replay(collection);
+
+        replay(TraceRecord::make(TraceOperation::APPEND, 0, 1));
+        replay(TraceRecord::make(TraceOperation::APPEND, 0, 2));
+        replay(TraceRecord::make(TraceOperation::PREPEND, 0, 3));
+        replay(TraceRecord::make(TraceOperation::INSERT, 1, 4));
+        replay(TraceRecord::make(TraceOperation::ERASE, 3));
+        replay(TraceRecord::make(TraceOperation::READ, 2));
+        replay(TraceRecord::make(TraceOperation::POP_FIRST));
+
+        BOOST_CHECK(contentsOf(collection) == std::vector<int>({4, 1}));
+        BOOST_CHECK_EQUAL(replay.getChecksum(), 1 + 3);
+        BOOST_CHECK_EQUAL(replay.getMismatches(), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenPositionsPastTheEnd_WhenReplaying_ThenTheyAreClampedAndCounted)
+    {
+        aisdi::LinkedList<int> collection = {1, 2, 3};
+        TraceReplayer<aisdi::LinkedList<int>> replay(collection);
+
+        replay(TraceRecord::make(TraceOperation::INSERT, 10, 4));
+        replay(TraceRecord::make(TraceOperation::ERASE, 10));
+        replay(TraceRecord::make(TraceOperation::READ, 10));
+        replay(TraceRecord::make(TraceOperation::ERASE_RANGE, 1, 10));
+
+        BOOST_CHECK(contentsOf(collection) == std::vector<int>({1}));
+        BOOST_CHECK_EQUAL(replay.getChecksum(), 3);
+        BOOST_CHECK_EQUAL(replay.getMismatches(), 4);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenReplayingRemovalsAndReads_ThenTheyAreSkippedAndCounted)
+    {
+        aisdi::Vector<int> collection;
+        TraceReplayer<aisdi::Vector<int>> replay(collection);
+
+        replay(TraceRecord::make(TraceOperation::POP_FIRST));
+        replay(TraceRecord::make(TraceOperation::POP_LAST));
+        replay(TraceRecord::make(TraceOperation::ERASE, 0));
+        replay(TraceRecord::make(TraceOperation::ERASE_RANGE, 0, 1));
+        replay(TraceRecord::make(TraceOperation::READ, 0));
+        replay(TraceRecord::make(TraceOperation::ITERATE));
+
+        BOOST_CHECK(collection.isEmpty());
+        BOOST_CHECK_EQUAL(replay.getMismatches(), 5);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenUnknownOperation_WhenReplaying_ThenItIsCounted)
+    {
+        aisdi::Vector<int> collection = {1};
+        TraceReplayer<aisdi::Vector<int>> replay(collection);
+        TraceRecord record = TraceRecord::make(TraceOperation::APPEND, 0, 5);
+        record.operation = static_cast<TraceOperation>(200);
+
+        replay(record);
+
+        BOOST_CHECK(contentsOf(collection) == std::vector<int>({1}));
+        BOOST_CHECK_EQUAL(replay.getMismatches(), 1);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,230 @@
+#include <PersistentVector.h>
+#include <OperationCountingObject.h>
+
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using aisdi::OperationCountingObject;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+        std::uint64_t,
+        std::complex<std::int32_t>,
+        OperationCountingObject>;
+
+namespace
+{
+
+    template<typename T>
+    aisdi::PersistentVector<T> createRange(int first, int last)
+    {
+        typename aisdi::PersistentVector<T>::Builder builder;
+        for (int i = first; i < last; ++i)
+            builder.append(i);
+
+        return builder.persistent();
+    }
+
+    std::vector<int> referenceRange(int first, int last)
+    {
+        std::vector<int> range;
+        for (int i = first; i < last; ++i)
+            range.push_back(i);
+
+        return range;
+    }
+
+    template<typename T>
+    void thenVersionMatches(const aisdi::PersistentVector<T> &version, const std::vector<int> &expected)
+    {
+        BOOST_REQUIRE_EQUAL(version.getSize(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+            BOOST_REQUIRE(version[i] == T(expected[i]));
+
+        std::size_t visited = 0;
+        version.forEach([&expected, &visited](const T &item) {
+            BOOST_REQUIRE(item == T(expected[visited]));
+            visited++;
+        });
+        BOOST_REQUIRE_EQUAL(visited, expected.size());
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(PersistentVectorTests)
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVersion_WhenCreated_ThenItIsEmpty,
+                                  T,
+                                  TestedTypes)
+    {
+        const aisdi::PersistentVector<T> version;
+
+        BOOST_CHECK(version.isEmpty());
+        BOOST_CHECK_EQUAL(version.getSize(), 0);
+        BOOST_CHECK_THROW(version.at(0), std::out_of_range);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVersion_WhenAppending_ThenEarlierVersionsAreUnchanged,
+                                  T,
+                                  TestedTypes)
+    {
+        std::vector<aisdi::PersistentVector<T>> versions(1);
+
+        for (int i = 0; i < 1200; ++i)
+            versions.push_back(versions.back().append(i));
+
+        for (int size : {0, 1, 31, 32, 33, 1024, 1025, 1200})
+            thenVersionMatches(versions[size], referenceRange(0, size));
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVersion_WhenSetting_ThenOnlyNewVersionChanges,
+                                  T,
+                                  TestedTypes)
+    {
+        const aisdi::PersistentVector<T> version = createRange<T>(0, 2000);
+
+        const aisdi::PersistentVector<T> changed = version.set(1500, 7).set(0, 8);
+
+        std::vector<int> expected = referenceRange(0, 2000);
+        thenVersionMatches(version, expected);
+        expected[1500] = 7;
+        expected[0] = 8;
+        thenVersionMatches(changed, expected);
+        BOOST_CHECK_THROW(version.set(2000, 1), std::out_of_range);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVersions_WhenConcatenating_ThenItemsFollowInOrder,
+                                  T,
+                                  TestedTypes)
+    {
+        for (int leftSize : {0, 1, 20, 32, 45, 1000, 1100, 40000})
+        {
+            for (int rightSize : {0, 5, 32, 700, 33000})
+            {
+                const aisdi::PersistentVector<T> joined =
+                        createRange<T>(0, leftSize).concat(createRange<T>(leftSize, leftSize + rightSize));
+
+                thenVersionMatches(joined, referenceRange(0, leftSize + rightSize));
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenVersion_WhenSlicing_ThenRangeIsKept,
+                                  T,
+                                  TestedTypes)
+    {
+        const aisdi::PersistentVector<T> version = createRange<T>(0, 5000);
+
+        thenVersionMatches(version.slice(0, 5000), referenceRange(0, 5000));
+        thenVersionMatches(version.slice(17, 4000), referenceRange(17, 4000));
+        thenVersionMatches(version.slice(1024, 1056), referenceRange(1024, 1056));
+        thenVersionMatches(version.slice(4999, 5000), referenceRange(4999, 5000));
+        BOOST_CHECK(version.slice(300, 300).isEmpty());
+        BOOST_CHECK_THROW(version.slice(10, 5001), std::out_of_range);
+        BOOST_CHECK_THROW(version.slice(10, 9), std::out_of_range);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSlicedVersion_WhenAppendingAndSetting_ThenItemsFollowReference,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::PersistentVector<T> version = createRange<T>(0, 3000).slice(45, 2100);
+        std::vector<int> expected = referenceRange(45, 2100);
+
+        for (int i = 0; i < 500; ++i)
+        {
+            version = version.append(-i);
+            expected.push_back(-i);
+        }
+        version = version.set(10, 11).set(2054, 12);
+        expected[10] = 11;
+        expected[2054] = 12;
+
+        thenVersionMatches(version, expected);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRandomSlicesAndConcatenations_WhenMixed_ThenItemsFollowReference,
+                                  T,
+                                  TestedTypes)
+    {
+        std::mt19937 random(2017);
+        aisdi::PersistentVector<T> version;
+        std::vector<int> expected;
+
+        for (int round = 0; round < 150; ++round)
+        {
+            const int size = static_cast<int>(random() % 300);
+            aisdi::PersistentVector<T> piece = createRange<T>(round * 1000, round * 1000 + size);
+            std::vector<int> expectedPiece = referenceRange(round * 1000, round * 1000 + size);
+
+            if (random() % 2 == 0)
+            {
+                version = version.concat(piece);
+                expected.insert(expected.end(), expectedPiece.begin(), expectedPiece.end());
+            }
+            else
+            {
+                version = piece.concat(version);
+                expected.insert(expected.begin(), expectedPiece.begin(), expectedPiece.end());
+            }
+
+            if (round % 10 == 9)
+            {
+                std::size_t first = random() % (expected.size() / 4 + 1);
+                std::size_t last = expected.size() - random() % (expected.size() / 4 + 1);
+                version = version.slice(first, last);
+                expected = std::vector<int>(expected.begin() + first, expected.begin() + last);
+            }
+        }
+
+        thenVersionMatches(version, expected);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBuilder_WhenChangingAfterPublishing_ThenPublishedVersionIsUnchanged,
+                                  T,
+                                  TestedTypes)
+    {
+        const aisdi::PersistentVector<T> base = { 1, 2, 3 };
+        typename aisdi::PersistentVector<T>::Builder builder(base);
+
+        for (int i = 4; i <= 100; ++i)
+            builder.append(i);
+        builder.set(0, 0);
+        const aisdi::PersistentVector<T> first = builder.persistent();
+
+        builder.set(1, 0);
+        builder.append(101);
+        const aisdi::PersistentVector<T> second = builder.persistent();
+
+        thenVersionMatches(base, { 1, 2, 3 });
+        std::vector<int> expected = referenceRange(1, 101);
+        expected[0] = 0;
+        thenVersionMatches(first, expected);
+        expected[1] = 0;
+        expected.push_back(101);
+        thenVersionMatches(second, expected);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenVersions_WhenAllAreDestroyed_ThenAllItemsAreDestroyed)
+    {
+        OperationCountingObject::resetCounters();
+        {
+            aisdi::PersistentVector<OperationCountingObject> version = createRange<OperationCountingObject>(0, 3000);
+            aisdi::PersistentVector<OperationCountingObject> other = version.slice(100, 2500).concat(version);
+            other = other.set(5, 5).append(6);
+            version = aisdi::PersistentVector<OperationCountingObject>();
+        }
+
+        BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(),
+                          OperationCountingObject::destroyedObjectsCount());
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
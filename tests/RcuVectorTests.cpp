@@ -0,0 +1,167 @@
+#include <RcuVector.h>
+#include <OperationCountingObject.h>
+
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using aisdi::OperationCountingObject;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+        std::uint64_t,
+        std::complex<std::int32_t>,
+        OperationCountingObject>;
+
+namespace
+{
+
+    template<typename T>
+    struct AppendItem
+    {
+        int item;
+
+        void operator()(aisdi::SharedVector<T> &version) const
+        {
+            version.append(item);
+        }
+    };
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(RcuVectorTests)
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReading_ThenInitialVersionIsVisited,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::RcuVector<T> collection(aisdi::SharedVector<T>{ 1, 2, 3 });
+        auto &reader = collection.addReader();
+        std::size_t size = 0;
+
+        reader.read([&size](const aisdi::SharedVector<T> &version) {
+            size = version.getSize();
+            BOOST_CHECK(version[2] == T(3));
+        });
+
+        BOOST_CHECK_EQUAL(size, 3);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenUpdating_ThenNextReadSeesNewVersion,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::RcuVector<T> collection;
+        auto &reader = collection.addReader();
+
+        collection.update(AppendItem<T>{7});
+        collection.publish(aisdi::SharedVector<T>{ 4, 5 });
+        collection.update(AppendItem<T>{6});
+
+        reader.read([](const aisdi::SharedVector<T> &version) {
+            BOOST_REQUIRE_EQUAL(version.getSize(), 3);
+            BOOST_CHECK(version[0] == T(4));
+            BOOST_CHECK(version[2] == T(6));
+        });
+        BOOST_CHECK_EQUAL(collection.getRetiredCount(), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenReaderInsideRead_WhenUpdating_ThenItsVersionIsKeptUntilItFinishes,
+                                  T,
+                                  TestedTypes)
+    {
+        aisdi::RcuVector<T> collection(aisdi::SharedVector<T>{ 1 });
+        auto &reader = collection.addReader();
+        auto &other = collection.addReader();
+
+        reader.read([&collection, &other](const aisdi::SharedVector<T> &version) {
+            collection.update(AppendItem<T>{2});
+            collection.update(AppendItem<T>{3});
+
+            BOOST_CHECK_EQUAL(collection.getRetiredCount(), 2);
+            BOOST_REQUIRE_EQUAL(version.getSize(), 1);
+            BOOST_CHECK(version[0] == T(1));
+
+            other.read([](const aisdi::SharedVector<T> &latest) {
+                BOOST_CHECK_EQUAL(latest.getSize(), 3);
+            });
+        });
+
+        collection.synchronize();
+        BOOST_CHECK_EQUAL(collection.getRetiredCount(), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenCollection_WhenDestroyed_ThenAllVersionsAreDestroyed)
+    {
+        OperationCountingObject::resetCounters();
+        {
+            aisdi::RcuVector<OperationCountingObject> collection;
+            auto &reader = collection.addReader();
+
+            reader.read([&collection](const aisdi::SharedVector<OperationCountingObject> &) {
+                for (int i = 0; i < 10; ++i)
+                    collection.update(AppendItem<OperationCountingObject>{i});
+            });
+        }
+
+        BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(),
+                          OperationCountingObject::destroyedObjectsCount());
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenReadersAndWriter_WhenRunningConcurrently_ThenEveryReadSeesOneWholeVersion)
+    {
+        const int readerCount = 3;
+        const int versions = 500;
+
+        aisdi::RcuVector<std::uint64_t> collection(aisdi::SharedVector<std::uint64_t>{ 0, 0, 0, 0 });
+        std::atomic<bool> done(false);
+        // Boost.Test assertions are not thread-safe.
+        std::atomic<int> misread(0);
+        std::vector<std::thread> threads;
+
+        for (int r = 0; r < readerCount; ++r)
+        {
+            threads.emplace_back([&collection, &done, &misread]() {
+                auto &reader = collection.addReader();
+                std::uint64_t last = 0;
+
+                while (!done.load(std::memory_order_acquire))
+                {
+                    reader.read([&misread, &last](const aisdi::SharedVector<std::uint64_t> &version) {
+                        for (std::size_t i = 1; i < version.getSize(); ++i)
+                            if (version[i] != version[0])
+                                misread++;
+
+                        if (version[0] < last)
+                            misread++;
+                        last = version[0];
+                    });
+                }
+            });
+        }
+
+        for (std::uint64_t v = 1; v <= versions; ++v)
+        {
+            collection.update([v](aisdi::SharedVector<std::uint64_t> &version) {
+                for (std::size_t i = 0; i < version.getSize(); ++i)
+                    version[i] = v;
+            });
+        }
+
+        done.store(true, std::memory_order_release);
+        for (std::thread &thread : threads)
+            thread.join();
+
+        collection.synchronize();
+        BOOST_CHECK_EQUAL(misread.load(), 0);
+        BOOST_CHECK_EQUAL(collection.getRetiredCount(), 0);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+#ifndef AISDI_LINEAR_REFERENCEMODEL_H
+#define AISDI_LINEAR_REFERENCEMODEL_H
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+// Checks for sequence containers against a std::vector<int> holding the
+// items they are expected to hold, and random operation drivers that apply
+// the same changes to both.
+namespace reference_model
+{
+
+    template<typename Collection>
+    void thenCollectionMatches(const Collection &collection, const std::vector<int> &expected)
+    {
+        BOOST_REQUIRE_EQUAL(collection.getSize(), expected.size());
+        BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(),
+                                      expected.begin(), expected.end());
+    }
+
+    // Also checks operator[] of random access containers.
+    template<typename Collection>
+    void thenIndexedCollectionMatches(const Collection &collection, const std::vector<int> &expected)
+    {
+        thenCollectionMatches(collection, expected);
+        for (std::size_t i = 0; i < expected.size(); ++i)
+            BOOST_REQUIRE_EQUAL(collection[i], expected[i]);
+    }
+
+    template<typename Collection>
+    void insertAt(Collection &collection, std::vector<int> &expected, std::size_t index, int item)
+    {
+        collection.insert(collection.begin() + index, item);
+        expected.insert(expected.begin() + index, item);
+    }
+
+    template<typename Collection>
+    void eraseAt(Collection &collection, std::vector<int> &expected, std::size_t first, std::size_t last)
+    {
+        collection.erase(collection.begin() + first, collection.begin() + last);
+        expected.erase(expected.begin() + first, expected.begin() + last);
+    }
+
+    // Inserts items first, first + 1, ... at random positions.
+    template<typename Collection>
+    void insertAtRandomPositions(Collection &collection, std::vector<int> &expected,
+                                 int first, int count, std::mt19937 &random)
+    {
+        for (int i = first; i < first + count; ++i)
+            insertAt(collection, expected, random() % (expected.size() + 1), i);
+    }
+
+    // Erases one item at a time at random positions until size are left.
+    template<typename Collection>
+    void eraseAtRandomPositions(Collection &collection, std::vector<int> &expected,
+                                std::size_t size, std::mt19937 &random)
+    {
+        while (expected.size() > size)
+        {
+            std::size_t index = random() % expected.size();
+            collection.erase(collection.begin() + index);
+            expected.erase(expected.begin() + index);
+        }
+    }
+
+    // Applies count random appends, prepends, popFirsts, range erases and
+    // inserts, with items first, first + 1, ...
+    template<typename Collection>
+    void mixAllOperations(Collection &collection, std::vector<int> &expected,
+                          int first, int count, std::mt19937 &random)
+    {
+        for (int i = first; i < first + count; ++i)
+        {
+            std::size_t index = random() % (expected.size() + 1);
+            switch (random() % 6)
+            {
+                case 0:
+                    collection.append(i);
+                    expected.push_back(i);
+                    break;
+                case 1:
+                    collection.prepend(i);
+                    expected.insert(expected.begin(), i);
+                    break;
+                case 2:
+                    if (!expected.empty())
+                    {
+                        BOOST_REQUIRE_EQUAL(collection.popFirst(), expected.front());
+                        expected.erase(expected.begin());
+                    }
+                    break;
+                case 3:
+                    if (index < expected.size())
+                        eraseAt(collection, expected, index, index + random() % (expected.size() - index + 1));
+                    break;
+                default:
+                    insertAt(collection, expected, index, i);
+            }
+        }
+    }
+
+} // namespace reference_model
+
+#endif // AISDI_LINEAR_REFERENCEMODEL_H
@@ -1,9 +1,14 @@
 #include <Vector.h>
+#include <OperationCountingObject.h>
+
+#include "ReferenceModel.h"
 
 #include <initializer_list>
 #include <complex>
 #include <cstdint>
 #include <cstddef>
+#include <new>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
@@ -13,117 +18,37 @@
 namespace
 {
 
-    class OperationCountingObject
-    {
-    public:
-        OperationCountingObject(int value_ = 0)
-                : value(value_)
-        {
-            ++constructedObjects;
-        }
-
-        OperationCountingObject(const OperationCountingObject &other)
-                : value(std::move(other.value))
-        {
-            ++constructedObjects;
-            ++copiedObjects;
-        }
-
-        OperationCountingObject(OperationCountingObject &&other)
-                : value(other.value)
-        {
-            ++constructedObjects;
-            ++movedObjects;
-        }
-
-        ~OperationCountingObject()
-        {
-            ++destroyedObjects;
-        }
-
-        OperationCountingObject &operator=(const OperationCountingObject &other)
-        {
-            ++assignedObjects;
-            value = other.value;
-            return *this;
-        }
-
-        OperationCountingObject &operator=(OperationCountingObject &&other)
-        {
-            ++assignedObjects;
-            ++movedObjects;
-            value = std::move(other.value);
-            return *this;
-        }
-
-        operator int() const
-        {
-            return value;
-        }
-
-        static void resetCounters()
-        {
-            constructedObjects = 0;
-            destroyedObjects = 0;
-            copiedObjects = 0;
-            movedObjects = 0;
-            assignedObjects = 0;
-        }
+    using aisdi::OperationCountingObject;
 
-        static std::size_t constructedObjectsCount()
-        {
-            return constructedObjects;
-        }
-
-        static std::size_t destroyedObjectsCount()
-        {
-            return destroyedObjects;
-        }
-
-        static std::size_t copiedObjectsCount()
-        {
-            return copiedObjects;
-        }
-
-        static std::size_t movedObjectsCount()
-        {
-            return movedObjects;
-        }
-
-        static std::size_t assignedObjectsCount()
+    struct Fixture
+    {
+        Fixture()
         {
-            return assignedObjects;
+            OperationCountingObject::resetCounters();
         }
-
-    private:
-        int value;
-
-        static std::size_t constructedObjects;
-        static std::size_t destroyedObjects;
-        static std::size_t copiedObjects;
-        static std::size_t movedObjects;
-        static std::size_t assignedObjects;
     };
 
-    std::size_t OperationCountingObject::constructedObjects = 0;
-    std::size_t OperationCountingObject::destroyedObjects = 0;
-    std::size_t OperationCountingObject::copiedObjects = 0;
-    std::size_t OperationCountingObject::movedObjects = 0;
-    std::size_t OperationCountingObject::assignedObjects = 0;
-
-    std::ostream &operator<<(std::ostream &out, const OperationCountingObject &obj)
+    // Its default constructor, which Vector uses to fill new buffers,
+    // throws while failConstruction is set.
+    struct FailingConstruction
     {
-        return out << '<' << static_cast<int>(obj) << '>';
-    }
+        static bool failConstruction;
+        int value;
 
-    struct Fixture
-    {
-        Fixture()
+        FailingConstruction()
+            : value(0)
         {
-            OperationCountingObject::resetCounters();
+            if (failConstruction)
+                throw std::bad_alloc();
         }
+
+        FailingConstruction(int value)
+            : value(value)
+        {}
     };
 
+    bool FailingConstruction::failConstruction = false;
+
 } // namespace
 
 template<typename T>
@@ -137,6 +62,8 @@ using TestedTypes = boost::mpl::list<std::int32_t,
 using std::begin;
 using std::end;
 
+using namespace reference_model;
+
 BOOST_FIXTURE_TEST_SUITE(VectorTests, Fixture)
 
     template<typename T>
@@ -933,6 +860,107 @@ BOOST_FIXTURE_TEST_SUITE(VectorTests, Fixture)
         BOOST_CHECK_EQUAL(collection.getSize(), 2);
     }
 
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIncrementalGrowth_WhenAppendingPastCapacity_ThenItemsAreKept,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection;
+        collection.enableIncrementalGrowth();
+        std::vector<int> expected;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            collection.append(i);
+            expected.push_back(i);
+        }
+
+        BOOST_CHECK(collection.hasIncrementalGrowth());
+        thenCollectionMatches(collection, expected);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionGrowingIncrementally_WhenModifying_ThenGrowthIsCompleted,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection(4);
+        collection.enableIncrementalGrowth();
+
+        for (int i = 0; i < 5; ++i)
+            collection.append(i);
+
+        collection.prepend(-1);
+        collection.insert(begin(collection) + 3, 100);
+        collection.append(5);
+        collection.erase(begin(collection) + 1);
+
+        BOOST_CHECK_EQUAL(collection.popLast(), 5);
+        BOOST_CHECK_EQUAL(collection.popFirst(), -1);
+        thenCollectionContainsValues(collection, {1, 100, 2, 3, 4});
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionGrowingIncrementally_WhenCopyingAndMoving_ThenItemsAreKept,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection(8);
+        collection.enableIncrementalGrowth();
+        std::vector<int> expected;
+
+        for (int i = 0; i < 9; ++i)
+        {
+            collection.append(i);
+            expected.push_back(i);
+        }
+
+        LinearCollection<T> copy{collection};
+        LinearCollection<T> assigned;
+        assigned = collection;
+        LinearCollection<T> moved{std::move(collection)};
+
+        BOOST_CHECK(copy.hasIncrementalGrowth());
+        BOOST_CHECK(moved.hasIncrementalGrowth());
+        thenCollectionMatches(copy, expected);
+        thenCollectionMatches(assigned, expected);
+        thenCollectionMatches(moved, expected);
+    }
+
+    BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionGrowingIncrementally_WhenDisablingIt_ThenItemsAreKept,
+                                  T,
+                                  TestedTypes)
+    {
+        LinearCollection<T> collection(2);
+        collection.enableIncrementalGrowth();
+
+        for (int i = 0; i < 3; ++i)
+            collection.append(i);
+
+        collection.disableIncrementalGrowth();
+        collection.append(3);
+
+        BOOST_CHECK(!collection.hasIncrementalGrowth());
+        thenCollectionContainsValues(collection, {0, 1, 2, 3});
+    }
+
+    BOOST_AUTO_TEST_CASE(GivenFullCollectionGrowingIncrementally_WhenAllocationFails_ThenItIsUnchanged)
+    {
+        aisdi::Vector<FailingConstruction> collection(4);
+        collection.enableIncrementalGrowth();
+        for (int i = 0; i < 4; ++i)
+            collection.append(i);
+
+        FailingConstruction::failConstruction = true;
+        BOOST_CHECK_THROW(collection.append(4), std::bad_alloc);
+        FailingConstruction::failConstruction = false;
+
+        BOOST_CHECK_EQUAL(collection.getSize(), 4);
+        BOOST_CHECK_EQUAL(collection.getCapacity(), 4);
+
+        collection.append(4);
+        collection.append(5);
+        for (int i = 0; i < 6; ++i)
+            BOOST_CHECK_EQUAL((*(begin(collection) + i)).value, i);
+    }
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 